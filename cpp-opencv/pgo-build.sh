@@ -0,0 +1,62 @@
+#!/bin/sh
+# Builds template-opencv with profile-guided and link-time optimisation:
+#  1. a plain build as the baseline,
+#  2. an instrumented build that is trained by the offline evaluator on recordings (h264 or raw BGRA frames),
+#  3. a rebuild in the same folder with the collected profile and LTO, which is installed to PREFIX,
+#  4. the benchmark of both builds side by side.
+# The recordings are PGO_RECORDINGS="a.rec b.rec", by default those in recordings/ next to this script,
+# which is part of the Docker build context, or else those one folder up. Only if none of them can be
+# evaluated does the training fall back to synthetic frames, which only approximate the real workload.
+set -e
+
+SOURCES=$(cd "$(dirname "$0")" && pwd)
+PREFIX=${PREFIX:-/tmp}
+FRAMES=${FRAMES:-2000}
+JOBS=${JOBS:-$(nproc)}
+BASELINE=$(pwd)/build-baseline
+BUILD=$(pwd)/build-pgo
+if [ -z "$PGO_RECORDINGS" ]; then
+    PGO_RECORDINGS=$(ls "$SOURCES"/recordings/*.rec 2>/dev/null || ls "$SOURCES"/../recordings/*.rec 2>/dev/null || true)
+fi
+
+echo "[pgo] Building the baseline in $BASELINE"
+mkdir -p "$BASELINE" && cd "$BASELINE"
+cmake -D CMAKE_BUILD_TYPE=Release "$SOURCES"
+make -j"$JOBS" template-opencv-bench
+
+echo "[pgo] Building the instrumented binaries in $BUILD"
+mkdir -p "$BUILD" && cd "$BUILD"
+find . -name '*.gcda' -delete
+cmake -D CMAKE_BUILD_TYPE=Release -D PGO=generate -D ENABLE_LTO=OFF "$SOURCES"
+make -j"$JOBS" template-opencv-evaluate
+
+echo "[pgo] Training"
+TRAINED=0
+for rec in $PGO_RECORDINGS; do
+    # Full and degraded path, as the microservice takes them
+    if ./template-opencv-evaluate --rec="$rec" && ./template-opencv-evaluate --rec="$rec" --reduced; then
+        echo "[pgo] Trained on $rec"
+        TRAINED=1
+    fi
+done
+if [ "$TRAINED" = "0" ]; then
+    echo "[pgo] No recording could be evaluated; training on synthetic frames instead"
+    ./template-opencv-evaluate --frames="$FRAMES"
+    ./template-opencv-evaluate --frames="$FRAMES" --seed=2 --yellow-left --dropout=0.4 --noise=8 --lighting=0.4
+    ./template-opencv-evaluate --frames="$FRAMES" --seed=3 --reduced
+fi
+
+echo "[pgo] Rebuilding with the profile and LTO"
+cmake -D CMAKE_BUILD_TYPE=Release -D CMAKE_INSTALL_PREFIX="$PREFIX" -D PGO=use -D ENABLE_LTO=ON "$SOURCES"
+make clean
+make -j"$JOBS"
+make install
+
+echo "[pgo] Comparing the baseline with the optimised build"
+"$BASELINE"/template-opencv-bench --frames="$FRAMES" > "$BASELINE"/bench.csv
+./template-opencv-bench --frames="$FRAMES" > bench.csv
+# Join the mean times of each stage and print the speedup
+awk -F';' 'NR == FNR { if (FNR > 2) baseline[$1 ";" $2] = $3; next }
+           FNR == 2 { print "stage;kernel;baseline mean us;pgo+lto mean us;speedup" }
+           FNR > 2 && (($1 ";" $2) in baseline) { printf "%s;%s;%.1f;%.1f;%.2f\n", $1, $2, baseline[$1 ";" $2], $3, baseline[$1 ";" $2] / $3 }' \
+    "$BASELINE"/bench.csv bench.csv
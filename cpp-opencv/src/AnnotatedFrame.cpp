@@ -0,0 +1,86 @@
+#include "AnnotatedFrame.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <ctime>
+#include <sstream>
+#include <string>
+
+constexpr uint32_t FrameMailbox::FRESH;
+
+void drawAnnotations(AnnotatedFrame &frame) {
+    // Draw a circle on the detected cones
+    const cv::Point2f dummy_cone;
+    for (const auto &cone : {frame.blueCones[0], frame.blueCones[1], frame.yellowCones[0], frame.yellowCones[1]}) {
+        if (cone != dummy_cone) {
+            cv::circle(frame.image, cone, 4, cv::Scalar(0,0,255), -1, 8, 0);
+        }
+    }
+
+    std::stringstream stream;
+    std::time_t time = static_cast<time_t>(frame.processedTime.seconds());
+    // The display and the dumper thread both annotate frames; gmtime would share one buffer between them
+    tm brokenDown{};
+    tm *p_time = gmtime_r(&time, &brokenDown);
+    stream << p_time->tm_year + 1900; // needed to add 1900 because ctime tm_year is current year - 1900
+
+    if (p_time->tm_mon < 10)
+    {
+        stream << "0";
+    }
+    stream << p_time->tm_mon + 1 // based on 0-11 range, +1 to correct
+           << "-";
+    if (p_time->tm_mday < 10)
+    {
+        stream << "0";
+    }
+    stream << p_time->tm_mday
+           << "T";
+    if (p_time->tm_hour < 10)
+    {
+        stream << "0";
+    }
+    stream << p_time->tm_hour + 2 // same as with the month, 0-23 hour range
+           << ":";
+    if (p_time->tm_min < 10)
+    {
+        stream << "0";
+    }
+    stream << p_time->tm_min
+           << ":";
+    if (p_time->tm_sec < 10)
+    {
+        stream << "0";
+    }
+    stream << p_time->tm_sec
+           << "Z";
+    std::string date = stream.str();
+
+    std::string output = "Now: " + date + "; ts: " + std::to_string(frame.captureTime) + ";";
+    cv::putText(frame.image,                // target image
+            output,                         // text
+            cv::Point(0, frame.image.rows / 8), // top-left position
+            cv::FONT_HERSHEY_PLAIN,
+            1.4,
+            CV_RGB(255, 255, 255),          // font color
+            1);
+
+    std::stringstream angles;
+    angles << "angle: " << frame.calculatedAngle << "; ground: " << frame.groundSteering << "; case: " << frame.coneCase;
+    cv::putText(frame.image, angles.str(), cv::Point(0, frame.image.rows - 8), cv::FONT_HERSHEY_PLAIN, 1.4, CV_RGB(255, 255, 255), 1);
+}
+
+bool FrameMailbox::post() noexcept {
+    // The slot in m_ready becomes our next back slot; if it was never taken, that frame is dropped
+    const uint32_t previous{m_ready.exchange(m_back | FRESH, std::memory_order_acq_rel)};
+    m_back = previous & ~FRESH;
+    return 0 == (previous & FRESH);
+}
+
+bool FrameMailbox::take() noexcept {
+    if (0 == (m_ready.load(std::memory_order_acquire) & FRESH)) {
+        return false;
+    }
+    m_front = m_ready.exchange(m_front, std::memory_order_acq_rel) & ~FRESH;
+    return true;
+}
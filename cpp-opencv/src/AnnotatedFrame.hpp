@@ -0,0 +1,59 @@
+#ifndef ANNOTATEDFRAME_HPP
+#define ANNOTATEDFRAME_HPP
+
+#include "cluon-complete.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Snapshot of what the frame loop saw and calculated, for looking at it on another thread
+struct AnnotatedFrame {
+    cv::Mat image{};                        // Region of interest (BGRA)
+    cv::Mat colorSpace{};                   // Black & white image of both colours before the noise removal
+    std::array<cv::Point2f,2> blueCones{};  // (0, 0) if not found
+    std::array<cv::Point2f,2> yellowCones{};
+    int64_t captureTime{0};                 // Time stamp of the frame in the shared memory area (in microseconds)
+    cluon::data::TimeStamp processedTime{};
+    float calculatedAngle{0.0f};
+    float groundSteering{0.0f};
+    uint32_t coneCase{0};
+};
+
+// Draws the detected cones, the time stamps and the calculated and ground steering onto the frame's image
+void drawAnnotations(AnnotatedFrame &frame);
+
+// Hands the latest AnnotatedFrame from the frame loop to one consumer thread through three preallocated
+// slots (triple buffering). The frame loop never waits: a frame that was not taken yet is replaced by the
+// newer one. Once the images in the slots have their size, copying into them does not allocate anymore.
+class FrameMailbox {
+   private:
+    FrameMailbox(const FrameMailbox &) = delete;
+    FrameMailbox(FrameMailbox &&)      = delete;
+    FrameMailbox &operator=(const FrameMailbox &) = delete;
+    FrameMailbox &operator=(FrameMailbox &&) = delete;
+
+   public:
+    FrameMailbox() = default;
+
+    // Frame loop: the slot to fill, then post it; returns false when the previous frame was dropped
+    AnnotatedFrame &back() noexcept { return m_slots[m_back]; }
+    bool post() noexcept;
+
+    // Consumer: takes the latest posted frame if there is a new one, then it is in front
+    bool take() noexcept;
+    AnnotatedFrame &front() noexcept { return m_slots[m_front]; }
+
+   private:
+    // Marks the slot in m_ready as posted and not taken yet
+    static constexpr uint32_t FRESH{4};
+
+    std::array<AnnotatedFrame,3> m_slots{};
+    uint32_t m_back{0};              // Owned by the frame loop
+    uint32_t m_front{1};             // Owned by the consumer
+    std::atomic<uint32_t> m_ready{2};
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "ConeDetector.hpp"
+#include "Trace.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cmath>
+
+// High and low values for blue and yellow colors
+const HsvRange BLUE{{100, 100, 40}, {133, 255, 255}};
+const HsvRange YELLOW{{15, 50, 130}, {25, 185, 255}};
+
+// Minimum contour areas of a cone and the minimum distance between two cones of the same colour at full resolution
+const double BLUE_CONE_AREA{20.0};
+const double YELLOW_CONE_AREA{40.0};
+const float CONE_DISTANCE{30.0f};
+
+ConeDetector::ConeDetector(const ThresholdKernel &threshold)
+    : m_threshold(threshold)
+    , m_fill(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(8, 8)))
+    , m_shrink(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(5, 5)))
+    , m_grow(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(7, 7)))
+    , m_fillReduced(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(4, 4)))
+    , m_shrinkReduced(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3)))
+    , m_growReduced(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(4, 4))) {
+}
+
+void ConeDetector::detect(const cv::Mat &roi, bool reducedResolution, std::array<cv::Point2f,2> &blueCones, std::array<cv::Point2f,2> &yellowCones) {
+    //--------------- Color detection section ---------------
+    // Convert the image to the hsv color space; the reduced resolution only looks at every other pixel
+    {
+        TRACE_SPAN("convert to hsv");
+        if (reducedResolution) {
+            cv::resize(roi, m_small, cv::Size(roi.cols / 2, roi.rows / 2), 0, 0, cv::INTER_NEAREST);
+            cv::cvtColor(m_small, m_hsv, cv::COLOR_BGR2HSV);
+        } else {
+            cv::cvtColor(roi, m_hsv, cv::COLOR_BGR2HSV);
+        }
+    }
+    // THIS DETECTS BLUE AND YELLOW CONES in one pass over the pixels
+    {
+        TRACE_SPAN("threshold");
+        m_blue.create(m_hsv.rows, m_hsv.cols, CV_8UC1);
+        m_yellow.create(m_hsv.rows, m_hsv.cols, CV_8UC1);
+        if (m_hsv.isContinuous() && m_blue.isContinuous() && m_yellow.isContinuous()) {
+            m_threshold.function(m_hsv.ptr(), m_hsv.total(), BLUE, YELLOW, m_blue.ptr(), m_yellow.ptr());
+        } else {
+            for (int32_t row{0}; row < m_hsv.rows; row++) {
+                m_threshold.function(m_hsv.ptr(row), static_cast<size_t>(m_hsv.cols), BLUE, YELLOW, m_blue.ptr(row), m_yellow.ptr(row));
+            }
+        }
+        // combines the two resulted images
+        cv::bitwise_or(m_blue, m_yellow, m_colorSpace);
+    }
+    //--------------- Color detection section ---------------
+
+    removeNoise(m_blue, reducedResolution);
+    removeNoise(m_yellow, reducedResolution);
+
+    // Areas shrink with the square and distances with the scale of the image
+    const float SCALE{reducedResolution ? 2.0f : 1.0f};
+    blueCones = findConeCentroids(m_blue, BLUE_CONE_AREA / (SCALE * SCALE), CONE_DISTANCE / SCALE);
+    yellowCones = findConeCentroids(m_yellow, YELLOW_CONE_AREA / (SCALE * SCALE), CONE_DISTANCE / SCALE);
+    if (reducedResolution) {
+        const cv::Point2f none;
+        for (auto *cones : {&blueCones, &yellowCones}) {
+            for (auto &cone : *cones) {
+                if (cone != none) {
+                    cone.x *= SCALE;
+                    cone.y *= SCALE;
+                }
+            }
+        }
+    }
+}
+
+void ConeDetector::removeNoise(cv::Mat &image, bool reducedResolution) {
+    TRACE_SPAN("remove noise");
+    // fill holes in objects
+    cv::dilate(image, image, reducedResolution ? m_fillReduced : m_fill);
+    cv::erode(image, image, reducedResolution ? m_fillReduced : m_fill);
+    // remove small objects
+    cv::erode(image, image, reducedResolution ? m_shrinkReduced : m_shrink);
+    cv::dilate(image, image, reducedResolution ? m_growReduced : m_grow);
+}
+
+//This method does the counturing/shape-detection.
+//the color detection happens outside this method and it recieves the black and white resulted image as an input
+//moreover, the parameter "contourArea" is also given to the method to later on be used for deciding if a detected element should
+//be considered a cone or not (based on its size/area)
+//This method returns the centre points of the cones (X,Y coordinates)
+std::array<cv::Point2f,2> ConeDetector::findConeCentroids(cv::Mat &inputImage, double contourArea, float distance)
+{
+    TRACE_SPAN("find cones");
+    m_contours.clear();
+    m_hierarchy.clear();
+    cv::findContours(inputImage, m_contours, m_hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
+    // Array of the detected cones
+    std::array<cv::Point2f,2> cones;
+    // Number of cones found so far
+    size_t num_cones = 0;
+
+    for (size_t i = 0; (i < m_contours.size()) && (num_cones < cones.size()); i++)       // Going through all the contours
+    {
+        if (cv::contourArea(m_contours[i]) > contourArea)     // If it reaches the treshhold (if it's big enough to be considered a cone)
+        {
+            // get the centroid of the figure from its moments
+            const cv::Moments mu = cv::moments(m_contours[i], false);
+            const cv::Point2f cone(static_cast<float>(mu.m10 / mu.m00), static_cast<float>(mu.m01 / mu.m00));
+            if (cone.x > 0) {
+                // The second cone must not be the same cone as the first one
+                if ((0 == num_cones) || (std::abs(cone.y - cones[0].y) > distance) || (std::abs(cone.x - cones[0].x) > distance))
+                {
+                    cones[num_cones] = cone;
+                    num_cones++;
+                }
+            }
+        }
+    }
+    return cones;
+}
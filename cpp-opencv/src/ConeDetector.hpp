@@ -0,0 +1,53 @@
+#ifndef CONEDETECTOR_HPP
+#define CONEDETECTOR_HPP
+
+#include "ThresholdKernels.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <vector>
+
+// Finds the blue and yellow cones in the region of interest of a frame. All intermediate images are
+// kept between the frames, so that their buffers are only allocated once. The colour threshold uses
+// the given variant of the kernel, by default the fastest one for this CPU.
+class ConeDetector {
+   public:
+    explicit ConeDetector(const ThresholdKernel &threshold = selectedThresholdKernel());
+
+    // Detects at most two cones of each colour in the given BGR(A) image; a cone that was not found is left as (0, 0).
+    // With reducedResolution, the colour detection and noise removal run on an image of half the width and height;
+    // the returned centroids are always in the coordinates of the given image.
+    void detect(const cv::Mat &roi, bool reducedResolution, std::array<cv::Point2f,2> &blueCones, std::array<cv::Point2f,2> &yellowCones);
+
+    // Black & white image of both colours before the noise removal, from the last call of detect
+    const cv::Mat &colorSpace() const noexcept { return m_colorSpace; }
+    const char *thresholdKernel() const noexcept { return m_threshold.name; }
+
+   private:
+    // Returns the centre points of at most two contours larger than contourArea that lie further apart than distance
+    std::array<cv::Point2f,2> findConeCentroids(cv::Mat &inputImage, double contourArea, float distance);
+    void removeNoise(cv::Mat &image, bool reducedResolution);
+
+   private:
+    const ThresholdKernel m_threshold;
+
+    cv::Mat m_small{};
+    cv::Mat m_hsv{};
+    cv::Mat m_blue{};
+    cv::Mat m_yellow{};
+    cv::Mat m_colorSpace{};
+
+    // Structuring elements for full and half resolution: fill holes, then remove small objects
+    cv::Mat m_fill{};
+    cv::Mat m_shrink{};
+    cv::Mat m_grow{};
+    cv::Mat m_fillReduced{};
+    cv::Mat m_shrinkReduced{};
+    cv::Mat m_growReduced{};
+
+    std::vector<std::vector<cv::Point>> m_contours{};
+    std::vector<cv::Vec4i> m_hierarchy{};
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "ConeStream.hpp"
+#include "Trace.hpp"
+
+#include <chrono>
+#include <iostream>
+
+cv::Rect regionOfInterest(uint32_t width, uint32_t height) {
+    return cv::Rect(0, static_cast<int32_t>(265 * height / 480), static_cast<int32_t>(width), static_cast<int32_t>(140 * height / 480));
+}
+
+ConeStream::ConeStream(uint32_t stream, const std::string &name, uint32_t width, uint32_t height, WorkerPool &pool, FusedCones &fusedCones)
+    : m_stream(stream)
+    , m_name(name)
+    , m_width(width)
+    , m_height(height)
+    , m_pool(pool)
+    , m_fusedCones(fusedCones)
+    , m_sharedMemory(new cluon::SharedMemory{name}) {
+    m_valid = m_sharedMemory->valid() && (m_sharedMemory->size() >= 4 * width * height);
+    if (m_valid) {
+        m_thread = std::thread(&ConeStream::run, this);
+    }
+}
+
+ConeStream::~ConeStream() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        std::unique_lock<std::mutex> lck(m_mutex);
+        // The next frame of the producer wakes up our waiting thread
+        if (!m_changed.wait_for(lck, std::chrono::milliseconds(500), [this]{ return m_stopped.load(); })) {
+            // The producer has gone quiet; notifying the area wakes up every process waiting on it,
+            // and a wake-up while our thread is copying a frame gets lost
+            while (!m_changed.wait_for(lck, std::chrono::milliseconds(100), [this]{ return m_stopped.load(); })) {
+                m_sharedMemory->notifyAll();
+            }
+        }
+        lck.unlock();
+        m_thread.join();
+    }
+    // The last detection job still uses the workspace
+    std::unique_lock<std::mutex> lck(m_mutex);
+    m_changed.wait(lck, [this]{ return !m_busy.load(); });
+}
+
+void ConeStream::run() {
+    trace::nameThread(("camera " + m_name).c_str());
+    const cv::Rect ROI{regionOfInterest(m_width, m_height)};
+    while (true) {
+        m_sharedMemory->wait();
+        if (!m_running.load()) {
+            break;
+        }
+        if (!m_sharedMemory->valid()) {
+            std::cerr << "[template-opencv] Shared memory area " << m_name << " is broken." << std::endl;
+            break;
+        }
+        const int64_t begin{cluon::time::toMicroseconds(cluon::time::now())};
+        m_sharedMemory->lock();
+        // Every notification of the producer wakes up all readers; with the SysV semaphores, a reader
+        // coming back before the producer has finished notifying returns at once, without a new frame
+        const int64_t captureTime{cluon::time::toMicroseconds(m_sharedMemory->getTimeStamp().second)};
+        if (captureTime == m_lastCaptureTime) {
+            m_sharedMemory->unlock();
+            continue;
+        }
+        m_lastCaptureTime = captureTime;
+        if (m_busy.load(std::memory_order_acquire)) {
+            m_sharedMemory->unlock();
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        {
+            TRACE_SPAN("copy frame");
+            cv::Mat wrapped(static_cast<int32_t>(m_height), static_cast<int32_t>(m_width), CV_8UC4, m_sharedMemory->data());
+            wrapped(ROI).copyTo(m_frame);
+        }
+        m_cones.captureTime = captureTime;
+        m_sharedMemory->unlock();
+        m_copied = cluon::time::toMicroseconds(cluon::time::now()) - begin;
+
+        m_busy.store(true, std::memory_order_release);
+        m_pool.submit([this]{ detect(); });
+    }
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_stopped.store(true);
+    }
+    m_changed.notify_all();
+}
+
+void ConeStream::detect() {
+    TRACE_SPAN("detect cones");
+    const int64_t begin{cluon::time::toMicroseconds(cluon::time::now())};
+    m_cones.stream = m_stream;
+    m_detector.detect(m_frame, false, m_cones.blueCones, m_cones.yellowCones);
+    m_fusedCones.post(m_cones);
+    m_processingTime.fetch_add(static_cast<uint64_t>(m_copied + cluon::time::toMicroseconds(cluon::time::now()) - begin), std::memory_order_relaxed);
+    m_processed.fetch_add(1, std::memory_order_relaxed);
+    // Notified under the lock, as the destructor may go ahead right after the unlock
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_busy.store(false, std::memory_order_release);
+    m_changed.notify_all();
+}
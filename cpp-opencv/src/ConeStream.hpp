@@ -0,0 +1,84 @@
+#ifndef CONESTREAM_HPP
+#define CONESTREAM_HPP
+
+#include "cluon-complete.hpp"
+#include "ConeDetector.hpp"
+#include "FusedCones.hpp"
+#include "WorkerPool.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Region of interest of a frame: the band in front of the car, without the sky and the car itself;
+// at 640x480, these are the rows 265 to 404
+cv::Rect regionOfInterest(uint32_t width, uint32_t height);
+
+// A further camera next to the one we steer with: its own thread waits for the frames in the shared
+// memory area and copies the region of interest of a frame into the stream's workspace; the cones are
+// detected on the shared worker pool with the stream's own detector and posted to the fused cones.
+// A frame that arrives while the previous one is still being detected is skipped, so that a slow
+// stream never queues up work on the pool.
+// There is no waiting with a timeout on the shared memory area: at destruction, the waiting thread
+// is left to the next frame of the producer for a while. Only if the producer has gone quiet, the
+// area is notified, which also wakes up the other processes waiting on it for a frame they had.
+class ConeStream {
+   private:
+    ConeStream(const ConeStream &) = delete;
+    ConeStream(ConeStream &&)      = delete;
+    ConeStream &operator=(const ConeStream &) = delete;
+    ConeStream &operator=(ConeStream &&) = delete;
+
+   public:
+    ConeStream(uint32_t stream, const std::string &name, uint32_t width, uint32_t height, WorkerPool &pool, FusedCones &fusedCones);
+    ~ConeStream();
+
+    bool valid() const noexcept { return m_valid; }
+    const std::string &name() const noexcept { return m_name; }
+
+    uint64_t numberOfProcessedFrames() const noexcept { return m_processed.load(std::memory_order_relaxed); }
+    uint64_t numberOfSkippedFrames() const noexcept { return m_skipped.load(std::memory_order_relaxed); }
+    // Accumulated time of copying and detecting in microseconds
+    uint64_t processingTime() const noexcept { return m_processingTime.load(std::memory_order_relaxed); }
+
+   private:
+    void run();
+    void detect();
+
+   private:
+    const uint32_t m_stream;
+    const std::string m_name;
+    const uint32_t m_width;
+    const uint32_t m_height;
+    WorkerPool &m_pool;
+    FusedCones &m_fusedCones;
+    std::unique_ptr<cluon::SharedMemory> m_sharedMemory;
+    bool m_valid{false};
+
+    // Workspace; owned by the waiting thread while m_busy is false, and by the detection job otherwise
+    ConeDetector m_detector{};
+    cv::Mat m_frame{};
+    StreamCones m_cones{};
+    int64_t m_copied{0};
+    std::atomic<bool> m_busy{false};
+    // Capture time of the latest frame that woke up the waiting thread
+    int64_t m_lastCaptureTime{0};
+
+    std::atomic<uint64_t> m_processed{0};
+    std::atomic<uint64_t> m_skipped{0};
+    std::atomic<uint64_t> m_processingTime{0};
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_stopped{false};
+    // Signals the end of a detection job and of the waiting thread to the destructor
+    std::mutex m_mutex{};
+    std::condition_variable m_changed{};
+    std::thread m_thread{};
+};
+
+#endif
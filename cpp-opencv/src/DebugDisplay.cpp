@@ -0,0 +1,46 @@
+#include "DebugDisplay.hpp"
+#include "Trace.hpp"
+
+#include <opencv2/highgui/highgui.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+DebugDisplay::DebugDisplay(const std::string &windowName, float maxRate)
+    : m_windowName(windowName)
+    , m_period(static_cast<int64_t>(1000.0f * 1000.0f / maxRate)) {
+    m_thread = std::thread(&DebugDisplay::run, this);
+}
+
+DebugDisplay::~DebugDisplay() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void DebugDisplay::submit() noexcept {
+    if (!m_mailbox.post()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void DebugDisplay::run() {
+    // All HighGUI calls stay on this thread
+    trace::nameThread("display");
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (m_running.load()) {
+        // Never catch up on the frames that took too long to show
+        nextFrame = std::max(nextFrame + m_period, std::chrono::steady_clock::now());
+        std::this_thread::sleep_until(nextFrame);
+        if (m_mailbox.take()) {
+            TRACE_SPAN("show frame");
+            AnnotatedFrame &frame = m_mailbox.front();
+            drawAnnotations(frame);
+            cv::imshow("Black & white Image", frame.colorSpace);
+            cv::imshow(m_windowName.c_str(), frame.image);
+            m_shown.fetch_add(1, std::memory_order_relaxed);
+        }
+        cv::waitKey(1);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef DEBUGDISPLAY_HPP
+#define DEBUGDISPLAY_HPP
+
+#include "AnnotatedFrame.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// Shows the frames of --verbose on its own thread at a capped rate. The frame loop only copies its
+// images into a snapshot and posts it; drawing the cones and the text, imshow and waitKey happen here,
+// so that looking at the frames does not change the latency of the steering.
+class DebugDisplay {
+   private:
+    DebugDisplay(const DebugDisplay &) = delete;
+    DebugDisplay(DebugDisplay &&)      = delete;
+    DebugDisplay &operator=(const DebugDisplay &) = delete;
+    DebugDisplay &operator=(DebugDisplay &&) = delete;
+
+   public:
+    DebugDisplay(const std::string &windowName, float maxRate);
+    ~DebugDisplay();
+
+    // Called from the frame loop: fill the snapshot, then submit it
+    AnnotatedFrame &snapshot() noexcept { return m_mailbox.back(); }
+    void submit() noexcept;
+
+    uint64_t numberOfShownFrames() const noexcept { return m_shown.load(std::memory_order_relaxed); }
+    uint64_t numberOfDroppedFrames() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+   private:
+    void run();
+
+   private:
+    const std::string m_windowName;
+    const std::chrono::microseconds m_period;
+
+    FrameMailbox m_mailbox{};
+    std::atomic<uint64_t> m_shown{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::atomic<bool> m_running{true};
+    std::thread m_thread{};
+};
+
+#endif
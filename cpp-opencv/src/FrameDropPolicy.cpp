@@ -0,0 +1,81 @@
+#include "FrameDropPolicy.hpp"
+
+#include <algorithm>
+
+constexpr uint32_t FrameDropPolicy::RECOVERY_FRAMES;
+constexpr uint32_t FrameDropPolicy::PROBE_EVERY;
+constexpr uint32_t FrameDropPolicy::INTERVAL_WINDOW;
+
+FrameDropPolicy::FrameDropPolicy(bool degradationAllowed) noexcept
+    : m_degradationAllowed(degradationAllowed) {
+}
+
+bool FrameDropPolicy::onFrame(int64_t captureTime) noexcept {
+    m_processed++;
+    const int64_t delta{captureTime - m_lastCapture};
+    if ((m_lastCapture > 0) && (delta > 0)) {
+        // Missing frames make some intervals longer and a frame captured early or late makes one shorter
+        // and the next longer; the median only moves when most of the intervals change. While we are
+        // too slow, every interval spans the frames we dropped; it is split up, so that the estimate
+        // stays the producer's interval even if we drop frames all the time.
+        const int64_t busy{std::max<int64_t>(0, m_lastFinish - m_lastCapture)};
+        const int64_t spanned{((m_interval > 0) && (busy >= m_interval)) ? std::max<int64_t>(1, (delta + m_interval / 2) / m_interval) : 1};
+        m_deltas[m_deltaCount % INTERVAL_WINDOW] = delta / spanned;
+        m_deltaCount++;
+        const size_t count{static_cast<size_t>(std::min<uint64_t>(m_deltaCount, INTERVAL_WINDOW))};
+        std::array<int64_t, INTERVAL_WINDOW> sorted(m_deltas);
+        std::nth_element(sorted.begin(), sorted.begin() + count / 2, sorted.begin() + count);
+        m_interval = sorted[count / 2];
+
+        // Counted over the last two intervals, where a frame captured off time cancels out; the frames
+        // missing in the first of them were counted before. Half an interval off is still on time.
+        const bool twoIntervals{m_captureBefore > 0};
+        const int64_t span{twoIntervals ? captureTime - m_captureBefore : delta};
+        const int64_t missing{std::max<int64_t>(0, (span + m_interval / 2 - 1) / m_interval - (twoIntervals ? 2 + m_lastMissing : 1))};
+        m_lastMissing = missing;
+        m_captureBefore = m_lastCapture;
+        if (missing > 0) {
+            // The missing frames captured before we finished the previous one arrived while we were busy
+            const int64_t dropped{std::min(missing, busy / m_interval)};
+            m_dropped += static_cast<uint64_t>(dropped);
+            m_producerGaps += static_cast<uint64_t>(missing - dropped);
+            if (dropped > 0) {
+                m_framesOnTime = 0;
+                m_degraded = m_degradationAllowed;
+            }
+        }
+    }
+    else {
+        // The time stamps start over
+        m_captureBefore = 0;
+        m_lastMissing = 0;
+    }
+    m_lastCapture = captureTime;
+
+    // Every now and then, a frame takes the full path to find out whether we would keep up again
+    m_fastPath = m_degraded && (0 != (m_processed % PROBE_EVERY));
+    if (m_fastPath) {
+        m_degradedFrames++;
+    }
+    return m_fastPath;
+}
+
+void FrameDropPolicy::onProcessed(int64_t finishTime) noexcept {
+    m_lastFinish = finishTime;
+    const int64_t latency{finishTime - m_lastCapture};
+    if (!m_fastPath) {
+        m_fullPathTime = (0 == m_fullPathTime) ? latency : (3 * m_fullPathTime + latency) / 4;
+    }
+    if (m_interval > 0) {
+        if (latency > m_interval) {
+            // The next frame arrived before we were done with this one
+            m_framesOnTime = 0;
+            m_degraded = m_degradationAllowed;
+        } else {
+            m_framesOnTime++;
+        }
+        if (m_degraded && (m_framesOnTime >= RECOVERY_FRAMES) && (5 * m_fullPathTime < 4 * m_interval)) {
+            m_degraded = false;
+        }
+    }
+}
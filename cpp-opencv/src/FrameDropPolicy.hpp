@@ -0,0 +1,58 @@
+#ifndef FRAMEDROPPOLICY_HPP
+#define FRAMEDROPPOLICY_HPP
+
+#include <array>
+#include <cstdint>
+
+// Accounts for the frames that we never saw and decides when to take the degraded fast path.
+// The producer's frame interval is estimated from the capture time stamps in the shared memory area,
+// as the median of the last intervals between them, so that neither missing frames nor a frame
+// captured early or late move the estimate, while a producer that really slows down or speeds up does.
+// A gap between two processed frames is blamed on us when the missing frames were captured while we
+// were still busy with the previous one (dropped), and on the producer otherwise (producer gap).
+// With degradation allowed, we switch to the fast path when frames are dropped or processing exceeds
+// the frame interval, and switch back once the full path fits into the frame interval again.
+class FrameDropPolicy {
+   public:
+    explicit FrameDropPolicy(bool degradationAllowed) noexcept;
+
+    // Called with the capture time of every frame we process (in microseconds); returns whether it shall use the fast path
+    bool onFrame(int64_t captureTime) noexcept;
+    // Called with the time point when the processing of that frame was finished (in microseconds)
+    void onProcessed(int64_t finishTime) noexcept;
+
+    bool degraded() const noexcept { return m_degraded; }
+    int64_t frameInterval() const noexcept { return m_interval; }
+    uint64_t processedFrames() const noexcept { return m_processed; }
+    uint64_t droppedFrames() const noexcept { return m_dropped; }
+    uint64_t producerGaps() const noexcept { return m_producerGaps; }
+    uint64_t degradedFrames() const noexcept { return m_degradedFrames; }
+
+   private:
+    // How many frames on time we want to see before leaving the fast path, and how often we try the full path meanwhile
+    static constexpr uint32_t RECOVERY_FRAMES{30};
+    static constexpr uint32_t PROBE_EVERY{10};
+    // Intervals between capture time stamps that the median is taken of (odd)
+    static constexpr uint32_t INTERVAL_WINDOW{15};
+
+    const bool m_degradationAllowed;
+    bool m_degraded{false};
+    bool m_fastPath{false};
+    uint32_t m_framesOnTime{0};
+
+    int64_t m_lastCapture{0};
+    int64_t m_captureBefore{0};  // Capture time of the frame before the last one
+    int64_t m_lastMissing{0};    // Frames missing before the last one
+    std::array<int64_t, INTERVAL_WINDOW> m_deltas{};
+    uint64_t m_deltaCount{0};
+    int64_t m_lastFinish{0};
+    int64_t m_interval{0};     // Estimated frame interval of the producer
+    int64_t m_fullPathTime{0}; // Smoothed processing time of the full path
+
+    uint64_t m_processed{0};
+    uint64_t m_dropped{0};
+    uint64_t m_producerGaps{0};
+    uint64_t m_degradedFrames{0};
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "FrameDumper.hpp"
+#include "Trace.hpp"
+
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cstring>
+
+FrameDumper::FrameDumper(const std::string &file, Format format, uint32_t everyNthFrame)
+    : m_format(format)
+    , m_everyNthFrame((0 == everyNthFrame) ? 1 : everyNthFrame)
+    , m_file(file, std::ios::out | std::ios::binary | std::ios::app)
+    , m_index(file + ".idx", std::ios::out | std::ios::app)
+    , m_valid(m_file.good() && m_index.good())
+    // Appending to an existing dump continues its offsets
+    , m_offset(m_valid ? static_cast<uint64_t>(m_file.seekp(0, std::ios::end).tellp()) : 0)
+    , m_encoderParameters{cv::IMWRITE_JPEG_QUALITY, 80} {
+    if (m_valid) {
+        m_thread = std::thread(&FrameDumper::run, this);
+    }
+}
+
+FrameDumper::~FrameDumper() {
+    {
+        std::lock_guard<std::mutex> lck(m_wakeUpMutex);
+        m_running.store(false);
+    }
+    m_wakeUp.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void FrameDumper::submit() noexcept {
+    if (!m_valid) {
+        return;
+    }
+    if (!m_mailbox.post()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    // The empty critical section only orders us with the writer going to sleep, so that no wake-up is lost.
+    {
+        std::lock_guard<std::mutex> lck(m_wakeUpMutex);
+        m_posted.store(true);
+    }
+    m_wakeUp.notify_one();
+}
+
+void FrameDumper::run() {
+    trace::nameThread("dumper");
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lck(m_wakeUpMutex);
+            m_wakeUp.wait(lck, [this]{ return !m_running.load() || m_posted.load(); });
+            m_posted.store(false);
+        }
+        // Write what was posted before stopping
+        if (m_mailbox.take()) {
+            write(m_mailbox.front());
+        } else if (!m_running.load()) {
+            break;
+        }
+    }
+    m_file.flush();
+    m_index.flush();
+}
+
+void FrameDumper::write(AnnotatedFrame &frame) {
+    TRACE_SPAN("write frame");
+    drawAnnotations(frame);
+
+    // Annotated region of interest on top, the mask of both colours below
+    const int32_t ROWS{frame.image.rows};
+    m_canvas.create(2 * ROWS, frame.image.cols, CV_8UC3);
+    cv::Mat top{m_canvas.rowRange(0, ROWS)};
+    cv::Mat bottom{m_canvas.rowRange(ROWS, 2 * ROWS)};
+    cv::cvtColor(frame.image, top, cv::COLOR_BGRA2BGR);
+    // Degraded frames have their mask at half resolution. An output of another size would be reallocated
+    // instead of written into the canvas; hence, the mask is converted on its own and then scaled into it.
+    cv::cvtColor(frame.colorSpace, m_mask, cv::COLOR_GRAY2BGR);
+    cv::resize(m_mask, bottom, bottom.size(), 0, 0, cv::INTER_NEAREST);
+
+    uint64_t size{0};
+    if (Format::Mjpeg == m_format) {
+        cv::imencode(".jpg", m_canvas, m_encoded, m_encoderParameters);
+        m_file.write(reinterpret_cast<const char*>(m_encoded.data()), static_cast<std::streamsize>(m_encoded.size()));
+        size = m_encoded.size();
+    } else {
+        DumpRecordHeader header;
+        std::memcpy(header.magic, "RAWF", sizeof(header.magic));
+        header.width = static_cast<uint32_t>(m_canvas.cols);
+        header.height = static_cast<uint32_t>(m_canvas.rows);
+        header.record = m_record;
+        header.captureTime = frame.captureTime;
+        header.calculatedAngle = frame.calculatedAngle;
+        header.groundSteering = frame.groundSteering;
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_file.write(reinterpret_cast<const char*>(m_canvas.data), static_cast<std::streamsize>(m_canvas.total() * m_canvas.elemSize()));
+        size = sizeof(header) + m_canvas.total() * m_canvas.elemSize();
+    }
+    m_index << m_record << ";" << frame.captureTime << ";" << m_offset << ";" << size << ";"
+            << frame.calculatedAngle << ";" << frame.groundSteering << ";" << frame.coneCase << "\n";
+    m_offset += size;
+    m_record++;
+    m_written.fetch_add(1, std::memory_order_relaxed);
+}
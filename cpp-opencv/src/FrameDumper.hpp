@@ -0,0 +1,89 @@
+#ifndef FRAMEDUMPER_HPP
+#define FRAMEDUMPER_HPP
+
+#include "AnnotatedFrame.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes every n-th frame, annotated and with its colour mask below, into one append-only file for
+// looking at the detections without a display. The frames are encoded and written on a background
+// thread that gets them through a FrameMailbox; if it falls behind, frames are replaced rather than
+// queued, so memory stays bounded and the frame loop never waits for the disk.
+//  - Mjpeg: concatenated JPEG images, playable with e.g. ffplay -f mjpeg
+//  - Raw:   per frame a DumpRecordHeader followed by the BGR pixels
+// Both formats get an index <file>.idx with one line "record;captureTime;offset;size;calculatedAngle;groundSteering;case" per written frame.
+class FrameDumper {
+   private:
+    FrameDumper(const FrameDumper &) = delete;
+    FrameDumper(FrameDumper &&)      = delete;
+    FrameDumper &operator=(const FrameDumper &) = delete;
+    FrameDumper &operator=(FrameDumper &&) = delete;
+
+   public:
+    enum class Format : uint8_t { Mjpeg, Raw };
+
+    // Header of a frame in the raw format; all fields are little endian
+    struct DumpRecordHeader {
+        char magic[4];          // "RAWF"
+        uint32_t width;
+        uint32_t height;        // Rows of the ROI and of the mask below it
+        uint32_t record;        // Number of the frame within the dump
+        int64_t captureTime;    // In microseconds
+        float calculatedAngle;
+        float groundSteering;
+    };
+
+   public:
+    FrameDumper(const std::string &file, Format format, uint32_t everyNthFrame);
+    ~FrameDumper();
+
+    bool valid() const noexcept { return m_valid; }
+
+    // Called from the frame loop for every frame; only every n-th frame wants a snapshot
+    bool wantsFrame() noexcept { return 0 == (m_frames++ % m_everyNthFrame); }
+    AnnotatedFrame &snapshot() noexcept { return m_mailbox.back(); }
+    void submit() noexcept;
+
+    uint64_t numberOfWrittenFrames() const noexcept { return m_written.load(std::memory_order_relaxed); }
+    uint64_t numberOfDroppedFrames() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+   private:
+    void run();
+    void write(AnnotatedFrame &frame);
+
+   private:
+    const Format m_format;
+    const uint32_t m_everyNthFrame;
+    uint64_t m_frames{0};
+    uint32_t m_record{0};
+
+    std::ofstream m_file{};
+    std::ofstream m_index{};
+    bool m_valid{false};
+    uint64_t m_offset{0};
+
+    // Only used by the background thread; allocated for the first frame and reused
+    cv::Mat m_canvas{};
+    cv::Mat m_mask{};
+    std::vector<uint8_t> m_encoded{};
+    std::vector<int> m_encoderParameters{};
+
+    FrameMailbox m_mailbox{};
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_posted{false};
+    std::mutex m_wakeUpMutex{};
+    std::condition_variable m_wakeUp{};
+    std::thread m_thread{};
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "FrameLoopMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+// From 1 ms to 1 s; the frame loop is meant to stay well below the frame interval
+const std::vector<double> SECONDS_BUCKETS{0.001, 0.002, 0.005, 0.01, 0.02, 0.033, 0.05, 0.1, 0.2, 0.5, 1.0};
+}
+
+FrameLoopMetrics::FrameLoopMetrics(MetricsRegistry &registry, const SteeringPublisher &publisher)
+    : m_frames(registry.counter("template_opencv_frames_total", "Frames processed"))
+    , m_processingTime(registry.histogram("template_opencv_processing_seconds", "Time from the notification of a frame to publishing its angle", SECONDS_BUCKETS))
+    , m_captureToPublish(registry.histogram("template_opencv_capture_to_publish_seconds", "Time from capturing a frame to publishing its angle", SECONDS_BUCKETS))
+    , m_droppedFrames(registry.counter("template_opencv_missed_frames_total", "Frames never processed", "reason=\"busy\""))
+    , m_producerGaps(registry.counter("template_opencv_missed_frames_total", "Frames never processed", "reason=\"producer\""))
+    , m_degradedFrames(registry.counter("template_opencv_degraded_frames_total", "Frames processed on the degraded fast path"))
+    , m_degraded(registry.gauge("template_opencv_degraded", "1 while the fast path is taken"))
+    , m_frameInterval(registry.gauge("template_opencv_frame_interval_seconds", "Estimated interval between the frames of the producer")) {
+    for (uint32_t i{0}; i < 6; i++) {
+        const std::string coneCase{"case=\"" + std::to_string(i + 1) + "\""};
+        m_framesPerCase[i] = &registry.counter("template_opencv_case_frames_total", "Frames per case of the steering calculation", coneCase);
+        m_correctPerCase[i] = &registry.counter("template_opencv_correct_frames_total", "Frames per case whose angle is within 70%-130% of the ground steering", coneCase + ",angle=\"raw\"");
+        m_filteredCorrectPerCase[i] = &registry.counter("template_opencv_correct_frames_total", "Frames per case whose angle is within 70%-130% of the ground steering", coneCase + ",angle=\"filtered\"");
+    }
+    // The accuracy follows from the counters above; sampled for those who look at it without a query
+    const auto framesPerCase = m_framesPerCase;
+    for (const auto &angle : {std::make_pair("raw", m_correctPerCase), std::make_pair("filtered", m_filteredCorrectPerCase)}) {
+        const auto correctPerCase = angle.second;
+        registry.gauge("template_opencv_accuracy_ratio", "Share of the frames whose angle is correct", std::string("angle=\"") + angle.first + "\"",
+            [framesPerCase, correctPerCase]{
+                uint64_t frames{0};
+                uint64_t correct{0};
+                for (size_t i{0}; i < framesPerCase.size(); i++) {
+                    frames += framesPerCase[i]->value();
+                    correct += correctPerCase[i]->value();
+                }
+                return (0 == frames) ? 0.0 : static_cast<double>(correct) / static_cast<double>(frames);
+            });
+    }
+    registry.counter("template_opencv_published_total", "GroundSteeringRequests sent", "",
+        [&publisher]{ return static_cast<double>(publisher.numberOfSentSamples()); });
+    registry.counter("template_opencv_publish_dropped_total", "GroundSteeringRequests dropped because the sender was behind", "",
+        [&publisher]{ return static_cast<double>(publisher.numberOfDroppedSamples()); });
+}
+
+void FrameLoopMetrics::onFrame(uint32_t coneCase, bool correct, bool filteredCorrect, int64_t processingTime, int64_t captureToPublish) noexcept {
+    const uint32_t i{((coneCase >= 1) && (coneCase <= 5)) ? coneCase - 1 : 5};
+    m_frames.increment();
+    m_framesPerCase[i]->increment();
+    if (correct) {
+        m_correctPerCase[i]->increment();
+    }
+    if (filteredCorrect) {
+        m_filteredCorrectPerCase[i]->increment();
+    }
+    m_processingTime.observe(static_cast<double>(processingTime) / 1000000.0);
+    m_captureToPublish.observe(static_cast<double>(captureToPublish) / 1000000.0);
+}
+
+void FrameLoopMetrics::onFrameDropPolicy(const FrameDropPolicy &frameDropPolicy) noexcept {
+    m_droppedFrames.set(frameDropPolicy.droppedFrames());
+    m_producerGaps.set(frameDropPolicy.producerGaps());
+    m_degradedFrames.set(frameDropPolicy.degradedFrames());
+    m_degraded.set(frameDropPolicy.degraded() ? 1.0 : 0.0);
+    m_frameInterval.set(static_cast<double>(frameDropPolicy.frameInterval()) / 1000000.0);
+}
@@ -0,0 +1,41 @@
+#ifndef FRAMELOOPMETRICS_HPP
+#define FRAMELOOPMETRICS_HPP
+
+#include "FrameDropPolicy.hpp"
+#include "Metrics.hpp"
+#include "SteeringPublisher.hpp"
+
+#include <array>
+#include <cstdint>
+
+// The metrics of the microservice's frame loop: frames and correct angles per case, dropped frames,
+// processing time and capture-to-publish latency. Registered once; the frame loop updates them.
+class FrameLoopMetrics {
+   private:
+    FrameLoopMetrics(const FrameLoopMetrics &) = delete;
+    FrameLoopMetrics(FrameLoopMetrics &&)      = delete;
+    FrameLoopMetrics &operator=(const FrameLoopMetrics &) = delete;
+    FrameLoopMetrics &operator=(FrameLoopMetrics &&) = delete;
+
+   public:
+    FrameLoopMetrics(MetricsRegistry &registry, const SteeringPublisher &publisher);
+
+    // Called once per frame from the frame loop; times are in microseconds
+    void onFrame(uint32_t coneCase, bool correct, bool filteredCorrect, int64_t processingTime, int64_t captureToPublish) noexcept;
+    void onFrameDropPolicy(const FrameDropPolicy &frameDropPolicy) noexcept;
+
+   private:
+    MetricCounter &m_frames;
+    std::array<MetricCounter*,6> m_framesPerCase{};
+    std::array<MetricCounter*,6> m_correctPerCase{};
+    std::array<MetricCounter*,6> m_filteredCorrectPerCase{};
+    MetricHistogram &m_processingTime;
+    MetricHistogram &m_captureToPublish;
+    MetricCounter &m_droppedFrames;
+    MetricCounter &m_producerGaps;
+    MetricCounter &m_degradedFrames;
+    MetricGauge &m_degraded;
+    MetricGauge &m_frameInterval;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "FusedCones.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+constexpr size_t FusedCones::HISTORY;
+
+FusedCones::FusedCones(const std::vector<std::string> &streamNames)
+    : m_names(streamNames)
+    , m_history(streamNames.size())
+    , m_posted(streamNames.size(), 0) {
+}
+
+void FusedCones::post(const StreamCones &cones) {
+    if (cones.stream >= m_names.size()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_history[cones.stream][m_posted[cones.stream] % HISTORY] = cones;
+    m_posted[cones.stream]++;
+}
+
+void FusedCones::latest(std::vector<StreamCones> &cones) const {
+    cones.clear();
+    std::lock_guard<std::mutex> lck(m_mutex);
+    for (size_t stream{0}; stream < m_names.size(); stream++) {
+        if (m_posted[stream] > 0) {
+            cones.push_back(m_history[stream][(m_posted[stream] - 1) % HISTORY]);
+        }
+    }
+}
+
+void FusedCones::near(int64_t captureTime, int64_t tolerance, std::vector<StreamCones> &cones) const {
+    cones.clear();
+    std::lock_guard<std::mutex> lck(m_mutex);
+    for (size_t stream{0}; stream < m_names.size(); stream++) {
+        const size_t kept{static_cast<size_t>(std::min<uint64_t>(m_posted[stream], HISTORY))};
+        const StreamCones *closest{nullptr};
+        for (size_t i{0}; i < kept; i++) {
+            const StreamCones &candidate = m_history[stream][i];
+            if ((nullptr == closest) || (std::llabs(candidate.captureTime - captureTime) < std::llabs(closest->captureTime - captureTime))) {
+                closest = &candidate;
+            }
+        }
+        if ((nullptr != closest) && (std::llabs(closest->captureTime - captureTime) <= tolerance)) {
+            cones.push_back(*closest);
+        }
+    }
+}
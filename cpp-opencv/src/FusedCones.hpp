@@ -0,0 +1,54 @@
+#ifndef FUSEDCONES_HPP
+#define FUSEDCONES_HPP
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// The cones that one stream (camera) detected in one frame; the positions are in the pixels of that
+// stream's region of interest, the capture time is in microseconds.
+struct StreamCones {
+    uint32_t stream{0};
+    int64_t captureTime{0};
+    std::array<cv::Point2f,2> blueCones{};
+    std::array<cv::Point2f,2> yellowCones{};
+};
+
+// Collects the cones of all streams of the process: every stream posts the cones of each frame, and
+// consumers ask for the cones of all streams at once. The last few frames of each stream are kept, so
+// that the frames of different cameras that were captured at about the same time can be matched.
+class FusedCones {
+   private:
+    FusedCones(const FusedCones &) = delete;
+    FusedCones(FusedCones &&)      = delete;
+    FusedCones &operator=(const FusedCones &) = delete;
+    FusedCones &operator=(FusedCones &&) = delete;
+
+   public:
+    explicit FusedCones(const std::vector<std::string> &streamNames);
+
+    // Called by the streams from any thread
+    void post(const StreamCones &cones);
+
+    // The cones of the latest frame of every stream that has seen a frame
+    void latest(std::vector<StreamCones> &cones) const;
+    // For every stream, the cones of the frame captured closest to captureTime, if at most tolerance away
+    void near(int64_t captureTime, int64_t tolerance, std::vector<StreamCones> &cones) const;
+
+    size_t numberOfStreams() const noexcept { return m_names.size(); }
+    const std::string &streamName(uint32_t stream) const { return m_names.at(stream); }
+
+   private:
+    static constexpr size_t HISTORY{8};
+
+    const std::vector<std::string> m_names;
+    mutable std::mutex m_mutex{};
+    std::vector<std::array<StreamCones, HISTORY>> m_history;
+    std::vector<uint64_t> m_posted;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+MetricHistogram::MetricHistogram(const std::vector<double> &upperBounds)
+    : m_upperBounds(upperBounds)
+    , m_buckets(new std::atomic<uint64_t>[upperBounds.size() + 1]) {
+    for (size_t i{0}; i <= m_upperBounds.size(); i++) {
+        m_buckets[i].store(0);
+    }
+}
+
+void MetricHistogram::observe(double value) noexcept {
+    // The few buckets are faster to scan than to search
+    size_t i{0};
+    while ((i < m_upperBounds.size()) && (value > m_upperBounds[i])) {
+        i++;
+    }
+    m_buckets[i].store(m_buckets[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_sum.store(m_sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    // Written last, so that a reader never sees more observations than in the buckets
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+MetricCounter &MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_counters.emplace_back();
+    add(name, help, labels, Type::Counter, m_counters.size() - 1);
+    return m_counters.back();
+}
+
+MetricGauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_gauges.emplace_back();
+    add(name, help, labels, Type::Gauge, m_gauges.size() - 1);
+    return m_gauges.back();
+}
+
+MetricHistogram &MetricsRegistry::histogram(const std::string &name, const std::string &help, const std::vector<double> &upperBounds, const std::string &labels) {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_histograms.emplace_back(upperBounds);
+    add(name, help, labels, Type::Histogram, m_histograms.size() - 1);
+    return m_histograms.back();
+}
+
+void MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels, std::function<double()> sample) {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_samples.push_back(std::move(sample));
+    add(name, help, labels, Type::SampledCounter, m_samples.size() - 1);
+}
+
+void MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels, std::function<double()> sample) {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_samples.push_back(std::move(sample));
+    add(name, help, labels, Type::SampledGauge, m_samples.size() - 1);
+}
+
+void MetricsRegistry::add(const std::string &name, const std::string &help, const std::string &labels, Type type, size_t index) {
+    m_entries.push_back(Entry{name, help, labels, type, index});
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    std::stringstream out;
+    out.precision(9);
+    // The samples of a name have to follow its HELP and TYPE together, also when their
+    // registrations were interleaved with those of other names
+    std::vector<const std::string *> names;
+    for (const Entry &entry : m_entries) {
+        if (std::find_if(names.begin(), names.end(), [&entry](const std::string *name){ return *name == entry.name; }) == names.end()) {
+            names.push_back(&entry.name);
+        }
+    }
+    for (const std::string *name : names) {
+        bool described{false};
+        for (const Entry &entry : m_entries) {
+            if (entry.name != *name) {
+                continue;
+            }
+            // HELP and TYPE once per name, from its first registration
+            if (!described) {
+                described = true;
+                const char *type{((Type::Counter == entry.type) || (Type::SampledCounter == entry.type)) ? "counter" :
+                                 ((Type::Histogram == entry.type) ? "histogram" : "gauge")};
+                out << "# HELP " << entry.name << " " << entry.help << "\n";
+                out << "# TYPE " << entry.name << " " << type << "\n";
+            }
+            render(entry, out);
+        }
+    }
+    return out.str();
+}
+
+void MetricsRegistry::render(const Entry &entry, std::ostream &out) const {
+    const std::string labels{entry.labels.empty() ? "" : "{" + entry.labels + "}"};
+    switch (entry.type) {
+        case Type::Counter: out << entry.name << labels << " " << m_counters[entry.index].value() << "\n"; break;
+        case Type::Gauge: out << entry.name << labels << " " << m_gauges[entry.index].value() << "\n"; break;
+        case Type::SampledCounter:
+        case Type::SampledGauge: out << entry.name << labels << " " << m_samples[entry.index]() << "\n"; break;
+        case Type::Histogram: {
+            const MetricHistogram &histogram{m_histograms[entry.index]};
+            const uint64_t count{histogram.count()};
+            const std::string separator{entry.labels.empty() ? "" : entry.labels + ","};
+            uint64_t cumulative{0};
+            for (size_t i{0}; i < histogram.upperBounds().size(); i++) {
+                cumulative += histogram.bucket(i);
+                out << entry.name << "_bucket{" << separator << "le=\"" << histogram.upperBounds()[i] << "\"} " << std::min(cumulative, count) << "\n";
+            }
+            out << entry.name << "_bucket{" << separator << "le=\"+Inf\"} " << count << "\n";
+            out << entry.name << "_sum" << labels << " " << histogram.sum() << "\n";
+            out << entry.name << "_count" << labels << " " << count << "\n";
+            break;
+        }
+    }
+}
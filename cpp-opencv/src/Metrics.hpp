@@ -0,0 +1,113 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Metrics are updated by exactly one thread (usually the frame loop) and read by the exporter at any time.
+// With a single writer, an update is a relaxed load and store of an atomic, i.e. a few plain instructions
+// without any locked read-modify-write.
+
+// Monotonically increasing number of events
+class MetricCounter {
+   public:
+    void increment(uint64_t n = 1) noexcept { m_value.store(m_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    // For events that are already counted elsewhere
+    void set(uint64_t total) noexcept { m_value.store(total, std::memory_order_relaxed); }
+    uint64_t value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+// Value that can go up and down
+class MetricGauge {
+   public:
+    void set(double value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+    double value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<double> m_value{0.0};
+};
+
+// Distribution of observed values over fixed buckets, given by their inclusive upper bounds in ascending order
+class MetricHistogram {
+   private:
+    MetricHistogram(const MetricHistogram &) = delete;
+    MetricHistogram(MetricHistogram &&)      = delete;
+    MetricHistogram &operator=(const MetricHistogram &) = delete;
+    MetricHistogram &operator=(MetricHistogram &&) = delete;
+
+   public:
+    explicit MetricHistogram(const std::vector<double> &upperBounds);
+
+    void observe(double value) noexcept;
+
+    const std::vector<double> &upperBounds() const noexcept { return m_upperBounds; }
+    // Observations in bucket i (not cumulative); the last bucket is everything above the largest bound
+    uint64_t bucket(size_t i) const noexcept { return m_buckets[i].load(std::memory_order_relaxed); }
+    uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    double sum() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+
+   private:
+    const std::vector<double> m_upperBounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<double> m_sum{0.0};
+};
+
+// Owns the metrics of a process and renders them in the Prometheus text format. Metrics are registered
+// at startup; the returned references stay valid for the lifetime of the registry. Metrics with the same
+// name but different labels (e.g. case="1") are registered one by one with the same name and help.
+class MetricsRegistry {
+   private:
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry(MetricsRegistry &&)      = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(MetricsRegistry &&) = delete;
+
+   public:
+    MetricsRegistry() = default;
+
+    // labels are given without braces, e.g. case="1"
+    MetricCounter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+    MetricGauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+    MetricHistogram &histogram(const std::string &name, const std::string &help, const std::vector<double> &upperBounds, const std::string &labels = "");
+    // Counter or gauge that is sampled when the metrics are rendered; sample must be safe to call from any thread
+    void counter(const std::string &name, const std::string &help, const std::string &labels, std::function<double()> sample);
+    void gauge(const std::string &name, const std::string &help, const std::string &labels, std::function<double()> sample);
+
+    // All metrics in the Prometheus text exposition format (version 0.0.4)
+    std::string render() const;
+
+   private:
+    enum class Type : uint8_t { Counter, Gauge, Histogram, SampledCounter, SampledGauge };
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::string labels;
+        Type type;
+        size_t index;
+    };
+
+    void add(const std::string &name, const std::string &help, const std::string &labels, Type type, size_t index);
+    // The samples of one entry
+    void render(const Entry &entry, std::ostream &out) const;
+
+    mutable std::mutex m_mutex{};
+    std::vector<Entry> m_entries{};
+    // Deques never move their elements, so that references to the metrics stay valid
+    std::deque<MetricCounter> m_counters{};
+    std::deque<MetricGauge> m_gauges{};
+    std::deque<MetricHistogram> m_histograms{};
+    std::vector<std::function<double()>> m_samples{};
+};
+
+#endif
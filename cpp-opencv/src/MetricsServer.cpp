@@ -0,0 +1,92 @@
+#include "MetricsServer.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+
+MetricsServer::MetricsServer(const MetricsRegistry &registry, uint16_t port)
+    : m_registry(registry) {
+    m_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket < 0) {
+        return;
+    }
+    const int32_t reuse{1};
+    ::setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if ((0 != ::bind(m_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) || (0 != ::listen(m_socket, 4))) {
+        ::close(m_socket);
+        m_socket = -1;
+        return;
+    }
+    m_thread = std::thread(&MetricsServer::run, this);
+}
+
+MetricsServer::~MetricsServer() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_socket >= 0) {
+        ::close(m_socket);
+    }
+}
+
+void MetricsServer::run() {
+    while (m_running.load()) {
+        // Wake up now and then to see whether we shall stop
+        struct pollfd listening{m_socket, POLLIN, 0};
+        if (::poll(&listening, 1, 200) > 0) {
+            const int32_t connection{::accept(m_socket, nullptr, nullptr)};
+            if (connection >= 0) {
+                serve(connection);
+                ::close(connection);
+            }
+        }
+    }
+}
+
+void MetricsServer::serve(int32_t connection) {
+    // A scraper that does not send its request within a second is not waited for
+    struct timeval timeout{1, 0};
+    ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && (request.size() < 8192)) {
+        const ssize_t received{::recv(connection, buffer, sizeof(buffer), 0)};
+        if (received <= 0) {
+            return;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    std::string status{"404 Not Found"};
+    std::string body{"Metrics are at /metrics\n"};
+    if ((0 == request.compare(0, 13, "GET /metrics ")) || (0 == request.compare(0, 6, "GET / "))) {
+        status = "200 OK";
+        body = m_registry.render();
+    }
+    const std::string response{"HTTP/1.0 " + status + "\r\n"
+                               "Content-Type: text/plain; version=0.0.4\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                               "Connection: close\r\n\r\n" + body};
+    size_t sent{0};
+    while (sent < response.size()) {
+        const ssize_t n{::send(connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL)};
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef METRICSSERVER_HPP
+#define METRICSSERVER_HPP
+
+#include "Metrics.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Minimal HTTP/1.0 endpoint for Prometheus: answers GET /metrics (and GET /) with the rendered registry.
+// It serves one request at a time on its own thread, which is all a scraper needs.
+class MetricsServer {
+   private:
+    MetricsServer(const MetricsServer &) = delete;
+    MetricsServer(MetricsServer &&)      = delete;
+    MetricsServer &operator=(const MetricsServer &) = delete;
+    MetricsServer &operator=(MetricsServer &&) = delete;
+
+   public:
+    MetricsServer(const MetricsRegistry &registry, uint16_t port);
+    ~MetricsServer();
+
+    bool valid() const noexcept { return m_socket >= 0; }
+
+   private:
+    void run();
+    void serve(int32_t connection);
+
+   private:
+    const MetricsRegistry &m_registry;
+    int32_t m_socket{-1};
+    std::atomic<bool> m_running{true};
+    std::thread m_thread{};
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "PerfCounters.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char *const NAMES[PerfCounters::COUNT]{"cycles", "instructions", "cache misses", "branch misses"};
+}
+
+PerfCounters::PerfCounters() noexcept {
+#if defined(__linux__)
+    const uint64_t CONFIGS[COUNT]{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int32_t c{0}; c < COUNT; c++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = CONFIGS[c];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // This thread on any CPU
+        m_fds[c] = static_cast<int32_t>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (m_fds[c] < 0) {
+            m_reasons += (m_reasons.empty() ? "" : "; ") + std::string(NAMES[c]) + ": " + std::strerror(errno);
+        }
+    }
+#else
+    m_reasons = "perf_event_open is only available on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (const int32_t fd : m_fds) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::available() const noexcept {
+    for (const int32_t fd : m_fds) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start() noexcept {
+#if defined(__linux__)
+    for (const int32_t fd : m_fds) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+PerfCounters::Reading PerfCounters::stop() noexcept {
+    Reading reading;
+#if defined(__linux__)
+    for (const int32_t fd : m_fds) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int32_t c{0}; c < COUNT; c++) {
+        // value, time enabled, time running
+        uint64_t data[3]{0, 0, 0};
+        if ((m_fds[c] >= 0) && (::read(m_fds[c], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data))) && (data[2] > 0)) {
+            reading.values[c] = static_cast<int64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]));
+        }
+    }
+#endif
+    return reading;
+}
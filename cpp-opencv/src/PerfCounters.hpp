@@ -0,0 +1,47 @@
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Hardware counters of the calling thread via perf_event_open (user space only): cycles, instructions,
+// cache misses and branch misses. Every counter is opened on its own, so that the ones the CPU or a
+// virtual machine does not offer are simply missing. In containers and with a restrictive
+// kernel.perf_event_paranoid, none of them may be available; reasons() tells why.
+class PerfCounters {
+   private:
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters(PerfCounters &&)      = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    PerfCounters &operator=(PerfCounters &&) = delete;
+
+   public:
+    enum Counter { CYCLES = 0, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, COUNT };
+
+    // Counts scaled to the full measuring time when the kernel had to multiplex the counters; -1 if not available
+    struct Reading {
+        std::array<int64_t, COUNT> values{{-1, -1, -1, -1}};
+
+        bool has(Counter c) const noexcept { return values[c] >= 0; }
+        int64_t operator[](Counter c) const noexcept { return values[c]; }
+    };
+
+    PerfCounters() noexcept;
+    ~PerfCounters();
+
+    bool available() const noexcept;
+    // Why counters could not be opened, empty if all of them were
+    const std::string &reasons() const noexcept { return m_reasons; }
+
+    // Resets and starts counting
+    void start() noexcept;
+    // Stops counting and returns the counts since start()
+    Reading stop() noexcept;
+
+   private:
+    std::array<int32_t, COUNT> m_fds{{-1, -1, -1, -1}};
+    std::string m_reasons{};
+};
+
+#endif
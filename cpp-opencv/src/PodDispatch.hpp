@@ -0,0 +1,113 @@
+#ifndef PODDISPATCH_HPP
+#define PODDISPATCH_HPP
+
+#include "ProtoReader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Dispatches an envelope to one handler for a set of message types that is known at compile time.
+// The handler is any callable with an overload handler(const Message &, const EnvelopeView &) for each
+// of the Messages (structs from od4-pod-generator). At compile time, the message identifiers are placed
+// into a table by identifier modulo the smallest size where no two of them collide (a perfect hash);
+// dispatching is one modulo, one compare and one call of a function that decodes the message and has
+// the handler inlined. Instead of a std::map lookup and a std::function call per message type.
+namespace pod {
+    enum class Dispatch : uint8_t { UNSUBSCRIBED, HANDLED, MALFORMED };
+
+    namespace detail {
+        template <typename Message, typename Handler>
+        Dispatch decodeAndHandle(const EnvelopeView &envelope, Handler &handler) {
+            Message message;
+            if (!decode(envelope.payload, envelope.payloadSize, message)) {
+                return Dispatch::MALFORMED;
+            }
+            handler(static_cast<const Message &>(message), envelope);
+            return Dispatch::HANDLED;
+        }
+
+        template <size_t N>
+        constexpr bool collisionFree(const int32_t (&ids)[N], uint32_t modulus) {
+            for (size_t i{0}; i < N; i++) {
+                for (size_t j{0}; j < i; j++) {
+                    if ((static_cast<uint32_t>(ids[i]) % modulus) == (static_cast<uint32_t>(ids[j]) % modulus)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool unique(const int32_t (&ids)[N]) {
+            for (size_t i{0}; i < N; i++) {
+                for (size_t j{0}; j < i; j++) {
+                    if (ids[i] == ids[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr uint32_t perfectModulus(const int32_t (&ids)[N]) {
+            uint32_t modulus{N};
+            while (!collisionFree(ids, modulus)) {
+                modulus++;
+            }
+            return modulus;
+        }
+    }
+
+    template <typename... Messages>
+    class MessageSet {
+       public:
+        static_assert(sizeof...(Messages) > 0, "A MessageSet needs at least one message type.");
+        static constexpr size_t SIZE{sizeof...(Messages)};
+        static constexpr int32_t IDS[SIZE]{Messages::ID()...};
+        static_assert(detail::unique(IDS), "Every message type may only appear once in a MessageSet.");
+        static constexpr uint32_t SLOTS{detail::perfectModulus(IDS)};
+
+        template <typename Handler>
+        static Dispatch dispatch(const EnvelopeView &envelope, Handler &handler) {
+            // Constant initialisation; no guard and no work at runtime
+            static constexpr Table<Handler> TABLE{table<Handler>()};
+            const Slot<Handler> &slot = TABLE.slots[static_cast<uint32_t>(envelope.dataType) % SLOTS];
+            if ((nullptr == slot.thunk) || (slot.id != envelope.dataType)) {
+                return Dispatch::UNSUBSCRIBED;
+            }
+            return slot.thunk(envelope, handler);
+        }
+
+       private:
+        template <typename Handler>
+        struct Slot {
+            int32_t id;
+            Dispatch (*thunk)(const EnvelopeView &, Handler &);
+        };
+
+        template <typename Handler>
+        struct Table {
+            Slot<Handler> slots[SLOTS];
+        };
+
+        template <typename Handler>
+        static constexpr Table<Handler> table() {
+            Table<Handler> t{};
+            const int32_t ids[SIZE]{Messages::ID()...};
+            Dispatch (*const thunks[SIZE])(const EnvelopeView &, Handler &){&detail::decodeAndHandle<Messages, Handler>...};
+            for (size_t i{0}; i < SIZE; i++) {
+                Slot<Handler> &slot = t.slots[static_cast<uint32_t>(ids[i]) % SLOTS];
+                slot.id = ids[i];
+                slot.thunk = thunks[i];
+            }
+            return t;
+        }
+    };
+
+    template <typename... Messages>
+    constexpr int32_t MessageSet<Messages...>::IDS[];
+}
+
+#endif
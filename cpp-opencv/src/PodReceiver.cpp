@@ -0,0 +1,83 @@
+#include "PodReceiver.hpp"
+#include "Trace.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+PodReceiver::PodReceiver(uint16_t cid)
+    // The largest UDP payload
+    : m_buffer(65535) {
+    m_socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_socket < 0) {
+        return;
+    }
+    // OD4Session is bound to the same port
+    const int32_t reuse{1};
+    ::setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(12175);
+
+    struct ip_mreq group;
+    std::memset(&group, 0, sizeof(group));
+    group.imr_interface.s_addr = htonl(INADDR_ANY);
+    if ((0 != ::bind(m_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+        || (1 != ::inet_pton(AF_INET, ("225.0.0." + std::to_string(cid)).c_str(), &group.imr_multiaddr))
+        || (0 != ::setsockopt(m_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group)))) {
+        ::close(m_socket);
+        m_socket = -1;
+    }
+}
+
+PodReceiver::~PodReceiver() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_socket >= 0) {
+        ::close(m_socket);
+    }
+}
+
+void PodReceiver::start() {
+    if (valid() && !m_thread.joinable()) {
+        m_thread = std::thread(&PodReceiver::run, this);
+    }
+}
+
+void PodReceiver::run() {
+    trace::nameThread("pod receiver");
+    while (m_running.load()) {
+        // Wake up now and then to see whether we shall stop
+        struct pollfd receiving{m_socket, POLLIN, 0};
+        if (::poll(&receiving, 1, 200) <= 0) {
+            continue;
+        }
+        const ssize_t size{::recv(m_socket, m_buffer.data(), m_buffer.size(), 0)};
+        if (size <= 0) {
+            continue;
+        }
+        m_received.fetch_add(1, std::memory_order_relaxed);
+
+        pod::EnvelopeView envelope;
+        if (!pod::decodeEnvelope(m_buffer.data(), static_cast<size_t>(size), envelope)) {
+            m_malformed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        envelope.received = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        for (auto &subscription : m_subscriptions) {
+            if (pod::Dispatch::MALFORMED == subscription(envelope)) {
+                m_malformed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef PODRECEIVER_HPP
+#define PODRECEIVER_HPP
+
+#include "PodDispatch.hpp"
+#include "ProtoReader.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Receives the datagrams of an OD4 session (multicast group 225.0.0.<CID>, port 12175) next to
+// cluon::OD4Session and decodes the fixed-layout messages generated by od4-pod-generator straight from
+// one preallocated receive buffer into plain structs on the stack. After start(), receiving a message
+// neither copies the datagram nor allocates, unlike OD4Session::dataTrigger with cluon::extractMessage.
+// This saves the decoding only: an OD4Session in the same process still receives and copies every
+// datagram on its own socket, so with both, each datagram is received twice.
+// Delegates run on the receiving thread, in the order the datagrams arrive.
+class PodReceiver {
+   private:
+    PodReceiver(const PodReceiver &) = delete;
+    PodReceiver(PodReceiver &&)      = delete;
+    PodReceiver &operator=(const PodReceiver &) = delete;
+    PodReceiver &operator=(PodReceiver &&) = delete;
+
+   public:
+    explicit PodReceiver(uint16_t cid);
+    ~PodReceiver();
+
+    bool valid() const noexcept { return m_socket >= 0; }
+
+    // Registers one handler for all Messages, with an overload handler(const Message &, const pod::EnvelopeView &)
+    // for each; the dispatch among them is resolved at compile time (pod::MessageSet). Only before start().
+    template <typename... Messages, typename Handler>
+    void subscribe(Handler handler) {
+        m_subscriptions.push_back([handler](const pod::EnvelopeView &envelope) mutable {
+            return pod::MessageSet<Messages...>::dispatch(envelope, handler);
+        });
+    }
+
+    // Registers a delegate for one message type; only before start()
+    template <typename Message>
+    void dataTrigger(std::function<void(const Message &, const pod::EnvelopeView &)> delegate) {
+        subscribe<Message>(std::move(delegate));
+    }
+
+    // Starts the receiving thread
+    void start();
+
+    uint64_t receivedDatagrams() const noexcept { return m_received.load(std::memory_order_relaxed); }
+    uint64_t malformedDatagrams() const noexcept { return m_malformed.load(std::memory_order_relaxed); }
+
+   private:
+    void run();
+
+   private:
+    int32_t m_socket{-1};
+    std::vector<std::function<pod::Dispatch(const pod::EnvelopeView &)>> m_subscriptions{};
+    std::vector<char> m_buffer;
+    std::atomic<bool> m_running{true};
+    std::atomic<uint64_t> m_received{0};
+    std::atomic<uint64_t> m_malformed{0};
+    std::thread m_thread{};
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef PROTOREADER_HPP
+#define PROTOREADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Reads the protobuf encoding of libcluon (ToProtoVisitor) in place: no copies, no allocations.
+// Signed integers are zigzag encoded, float and double are little endian fixed32 and fixed64, and
+// bool, char and unsigned integers are plain varints. The decoders generated by od4-pod-generator
+// call read() for the fields they know; everything else is skipped.
+namespace pod {
+    enum WireType : uint8_t { VARINT = 0, EIGHT_BYTES = 1, LENGTH_DELIMITED = 2, FOUR_BYTES = 5 };
+
+    class ProtoReader {
+       public:
+        ProtoReader(const char *data, size_t size) noexcept
+            : m_position(reinterpret_cast<const uint8_t *>(data))
+            , m_end(m_position + size) {}
+
+        // Moves to the next field; false at the end or when the data is malformed
+        bool next() noexcept {
+            if ((m_position == m_end) || !m_ok) {
+                return false;
+            }
+            uint64_t key{0};
+            if (!varint(key)) {
+                return false;
+            }
+            m_fieldIdentifier = static_cast<uint32_t>(key >> 3);
+            m_wireType = static_cast<uint8_t>(key & 0x7);
+            switch (m_wireType) {
+                case VARINT: return varint(m_value);
+                case EIGHT_BYTES: return fixed(8);
+                case FOUR_BYTES: return fixed(4);
+                case LENGTH_DELIMITED:
+                    if (!varint(m_value) || (m_value > static_cast<uint64_t>(m_end - m_position))) {
+                        return fail();
+                    }
+                    m_bytes = reinterpret_cast<const char *>(m_position);
+                    m_position += m_value;
+                    return true;
+                default: return fail();
+            }
+        }
+
+        // False if the data ended in the middle of a field
+        bool ok() const noexcept { return m_ok; }
+        uint32_t fieldIdentifier() const noexcept { return m_fieldIdentifier; }
+
+        // Each returns false and leaves v alone if the field has a different wire type
+        bool read(bool &v) const noexcept { return unsignedValue(v); }
+        bool read(char &v) const noexcept { return unsignedValue(v); }
+        bool read(uint8_t &v) const noexcept { return unsignedValue(v); }
+        bool read(uint16_t &v) const noexcept { return unsignedValue(v); }
+        bool read(uint32_t &v) const noexcept { return unsignedValue(v); }
+        bool read(uint64_t &v) const noexcept { return unsignedValue(v); }
+        bool read(int8_t &v) const noexcept { return signedValue(v); }
+        bool read(int16_t &v) const noexcept { return signedValue(v); }
+        bool read(int32_t &v) const noexcept { return signedValue(v); }
+        bool read(int64_t &v) const noexcept { return signedValue(v); }
+        bool read(float &v) const noexcept {
+            if (FOUR_BYTES != m_wireType) {
+                return false;
+            }
+            const uint32_t bits{static_cast<uint32_t>(m_value)};
+            std::memcpy(&v, &bits, sizeof(v));
+            return true;
+        }
+        bool read(double &v) const noexcept {
+            if (EIGHT_BYTES != m_wireType) {
+                return false;
+            }
+            std::memcpy(&v, &m_value, sizeof(v));
+            return true;
+        }
+        // Bytes of a string, byte array or nested message; they point into the data given to the constructor
+        bool read(const char *&bytes, size_t &size) const noexcept {
+            if (LENGTH_DELIMITED != m_wireType) {
+                return false;
+            }
+            bytes = m_bytes;
+            size = static_cast<size_t>(m_value);
+            return true;
+        }
+
+       private:
+        bool fail() noexcept {
+            m_ok = false;
+            return false;
+        }
+
+        bool varint(uint64_t &v) noexcept {
+            v = 0;
+            for (uint32_t shift{0}; (m_position != m_end) && (shift < 64); shift += 7) {
+                const uint8_t b{*m_position++};
+                v |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if (0 == (b & 0x80)) {
+                    return true;
+                }
+            }
+            return fail();
+        }
+
+        bool fixed(uint32_t bytes) noexcept {
+            if (static_cast<size_t>(m_end - m_position) < bytes) {
+                return fail();
+            }
+            // Little endian on the wire
+            m_value = 0;
+            for (uint32_t i{0}; i < bytes; i++) {
+                m_value |= static_cast<uint64_t>(m_position[i]) << (8 * i);
+            }
+            m_position += bytes;
+            return true;
+        }
+
+        template <typename T>
+        bool unsignedValue(T &v) const noexcept {
+            if (VARINT != m_wireType) {
+                return false;
+            }
+            v = static_cast<T>(m_value);
+            return true;
+        }
+
+        template <typename T>
+        bool signedValue(T &v) const noexcept {
+            if (VARINT != m_wireType) {
+                return false;
+            }
+            v = static_cast<T>(static_cast<int64_t>(m_value >> 1) ^ -static_cast<int64_t>(m_value & 1));
+            return true;
+        }
+
+        const uint8_t *m_position;
+        const uint8_t *const m_end;
+        bool m_ok{true};
+        uint32_t m_fieldIdentifier{0};
+        uint8_t m_wireType{0};
+        uint64_t m_value{0};
+        const char *m_bytes{nullptr};
+    };
+
+    // cluon::data::Envelope without copying the payload; the times are in microseconds since the epoch
+    struct EnvelopeView {
+        int32_t dataType{0};
+        uint32_t senderStamp{0};
+        int64_t sent{0};
+        int64_t received{0};
+        int64_t sampleTimeStamp{0};
+        const char *payload{nullptr};
+        size_t payloadSize{0};
+    };
+
+    // cluon::data::TimeStamp
+    inline bool decodeTimeStamp(const char *data, size_t size, int64_t &microseconds) noexcept {
+        int32_t seconds{0};
+        int32_t micros{0};
+        ProtoReader reader{data, size};
+        while (reader.next()) {
+            if (1 == reader.fieldIdentifier()) {
+                reader.read(seconds);
+            } else if (2 == reader.fieldIdentifier()) {
+                reader.read(micros);
+            }
+        }
+        microseconds = static_cast<int64_t>(seconds) * 1000 * 1000 + micros;
+        return reader.ok();
+    }
+
+    // One OD4 datagram: 0x0D 0xA4, the 24-bit little endian length, and the encoded Envelope
+    inline bool decodeEnvelope(const char *datagram, size_t size, EnvelopeView &envelope) noexcept {
+        const size_t HEADER_SIZE{5};
+        if ((size < HEADER_SIZE) || (0x0D != static_cast<uint8_t>(datagram[0])) || (0xA4 != static_cast<uint8_t>(datagram[1]))) {
+            return false;
+        }
+        const size_t LENGTH{static_cast<size_t>(static_cast<uint8_t>(datagram[2]))
+                            | (static_cast<size_t>(static_cast<uint8_t>(datagram[3])) << 8)
+                            | (static_cast<size_t>(static_cast<uint8_t>(datagram[4])) << 16)};
+        if (size - HEADER_SIZE < LENGTH) {
+            return false;
+        }
+        bool ok{true};
+        ProtoReader reader{datagram + HEADER_SIZE, LENGTH};
+        while (reader.next()) {
+            const char *bytes{nullptr};
+            size_t bytesSize{0};
+            switch (reader.fieldIdentifier()) {
+                case 1: reader.read(envelope.dataType); break;
+                case 2: reader.read(envelope.payload, envelope.payloadSize); break;
+                case 3: ok = ok && reader.read(bytes, bytesSize) && decodeTimeStamp(bytes, bytesSize, envelope.sent); break;
+                case 4: ok = ok && reader.read(bytes, bytesSize) && decodeTimeStamp(bytes, bytesSize, envelope.received); break;
+                case 5: ok = ok && reader.read(bytes, bytesSize) && decodeTimeStamp(bytes, bytesSize, envelope.sampleTimeStamp); break;
+                case 6: reader.read(envelope.senderStamp); break;
+                default: break;
+            }
+        }
+        return ok && reader.ok();
+    }
+}
+
+#endif
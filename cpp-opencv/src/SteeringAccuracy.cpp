@@ -0,0 +1,48 @@
+#include "SteeringAccuracy.hpp"
+
+#include <numeric>
+
+bool SteeringAccuracy::isCorrect(float groundSteering, float calculatedAngle) noexcept {
+    // Based on the criteria provided by the customer, we check if the calculated angle is in the desired range of 70%-130%
+    if (groundSteering > 0.0f) {
+        return (groundSteering * 0.7f < calculatedAngle) && (calculatedAngle < 1.3f * groundSteering);
+    }
+    else if (groundSteering < 0.0f) {
+        return (groundSteering * 0.7f > calculatedAngle) && (groundSteering * 1.3f < calculatedAngle);
+    }
+    return (calculatedAngle < 0.05f) && (calculatedAngle > -0.05f);
+}
+
+bool SteeringAccuracy::count(uint32_t coneCase, float groundSteering, float calculatedAngle) noexcept {
+    const uint32_t i{index(coneCase)};
+    m_frames[i]++;
+    const bool correct{isCorrect(groundSteering, calculatedAngle)};
+    if (correct) {
+        m_correct[i]++;
+    }
+    return correct;
+}
+
+uint64_t SteeringAccuracy::frames() const noexcept {
+    return std::accumulate(m_frames.begin(), m_frames.end(), uint64_t{0});
+}
+
+double SteeringAccuracy::averageAccuracy() const noexcept {
+    const uint64_t all{frames()};
+    const uint64_t correct{std::accumulate(m_correct.begin(), m_correct.end(), uint64_t{0})};
+    return (0 == all) ? 0.0 : 100.0 * static_cast<double>(correct) / static_cast<double>(all);
+}
+
+uint64_t SteeringAccuracy::frames(uint32_t coneCase) const noexcept {
+    return m_frames[index(coneCase)];
+}
+
+double SteeringAccuracy::accuracy(uint32_t coneCase) const noexcept {
+    const uint32_t i{index(coneCase)};
+    return (0 == m_frames[i]) ? 0.0 : 100.0 * static_cast<double>(m_correct[i]) / static_cast<double>(m_frames[i]);
+}
+
+uint32_t SteeringAccuracy::index(uint32_t coneCase) noexcept {
+    // Anything that is not one of the cases 1..5 was calculated without cones
+    return ((coneCase >= 1) && (coneCase <= 5)) ? coneCase - 1 : 5;
+}
@@ -0,0 +1,31 @@
+#ifndef STEERINGACCURACY_HPP
+#define STEERINGACCURACY_HPP
+
+#include <array>
+#include <cstdint>
+
+// Counts the frames and correct calculations for each of the six cases of the SteeringCalculator.
+// A calculated angle is correct when it lies within 70%-130% of the ground steering, or within
+// +-0.05 when the ground steering is exactly zero (the criteria provided by the customer).
+class SteeringAccuracy {
+   public:
+    static bool isCorrect(float groundSteering, float calculatedAngle) noexcept;
+
+    // Returns whether the calculated angle was correct
+    bool count(uint32_t coneCase, float groundSteering, float calculatedAngle) noexcept;
+
+    // Over all frames, and for case 1..6; accuracies are in percent
+    uint64_t frames() const noexcept;
+    double averageAccuracy() const noexcept;
+    uint64_t frames(uint32_t coneCase) const noexcept;
+    double accuracy(uint32_t coneCase) const noexcept;
+
+   private:
+    static uint32_t index(uint32_t coneCase) noexcept;
+
+   private:
+    std::array<uint64_t,6> m_frames{};
+    std::array<uint64_t,6> m_correct{};
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "SteeringCalculator.hpp"
+
+#include <cmath>
+
+float SteeringCalculator::calculateAngle(std::array<cv::Point2f,2> blueCones, std::array<cv::Point2f,2> yellowCones, uint32_t &coneCase) {
+
+    float calculatedAngle = 0.0;    // Our calculated angle result
+    cv::Point2f dummy_cone;         // You might laugh at this but comparing an actual cone against a null one (dummy_cone), was the only way we could see if there exists a cone
+    float midd_point = 0;           // The middle X value
+    float negative = -1.0;          // Variable for negative number
+    float offset = 0;               // The distance from the middle point to the center of the screen
+    // Magic values for the calculations of the steering angle
+    float c1 = 0.00035f;            
+    float c2 = 0.18f;
+    float c3 = 0.0000100f;
+    float c4 = 0.0000100f;
+    float width = 640.0;            // Width of the screen
+    float midd_width = 320.0;       // Half of the size of the width
+
+	if(blueCones[0] != dummy_cone && yellowCones[0] != dummy_cone) {        // There exists a cone of each color
+        //std::cout << "Case 1" << std::endl;
+        coneCase = 1;                                                       // Remembering the frame was calculated with case 1
+        if (yellowCones[0].x < blueCones[0].x) {                            // Check if the yellow cone is on the left
+            m_isYellowLeft = true;                                            // if yes true
+        }
+        else {
+            m_isYellowLeft = false;                                           // if not false
+        }
+        m_isClockwiseKnown = true;                                            // we know the direction we're going
+		midd_point = (blueCones[0].x + yellowCones[0].x)/2;                 // calculate the midd ponit of the two cones (X)
+        offset = midd_width - midd_point;                                   // get the offset of that from the center point
+        calculatedAngle = offset * c1;                                      // multiply by the constant
+	} else if(blueCones[0] != dummy_cone && blueCones[1] != dummy_cone) {       // Only two blue cones are detected
+        //std::cout << "Case 2" << std::endl;
+        blueCones[0].y = 480 - blueCones[0].y;                              // reverse the height
+        blueCones[1].y = 480 - blueCones[1].y;                              // reverse the height
+        coneCase = 2;                                                       // Remembering the frame was calculated with case 2
+        if ((blueCones[0].y < blueCones[1].y) || (blueCones[0].y > blueCones[1].y)) {                             // if the cones' Y values are not the same
+
+            if (blueCones[0].y < 70)                                        // if the distance of the first cone is less than 70, return 0.0
+            {
+                calculatedAngle = 0.0;
+            } else {
+            
+            calculatedAngle = (blueCones[0].x - blueCones[1].x);            // otherwise, get the distnace of the two cones (X)
+            calculatedAngle = calculatedAngle * 0.0005f;                     // multiply that by the constant
+            }
+        } else {
+            calculatedAngle = 0.0;                                          // otherwise, return 0.0
+        }   
+	} else if(yellowCones[0] != dummy_cone && yellowCones[1] != dummy_cone) {       //Only two yellow cones are detected
+        //std::cout << "Case 3" << std::endl;
+        // Same as above
+        yellowCones[0].y = 480 - yellowCones[0].y;                                  
+        yellowCones[1].y = 480 - yellowCones[1].y;                                  
+        coneCase = 3;
+        if ((yellowCones[0].y < yellowCones[1].y) || (yellowCones[0].y > yellowCones[1].y)){                 
+            // The difference here is that we calculate the inverse of the gradient and we get the atan    
+            calculatedAngle = negative * ((yellowCones[0].x - yellowCones[1].x) / (yellowCones[0].y - yellowCones[1].y));
+            calculatedAngle = std::atan(calculatedAngle/100);
+            calculatedAngle = calculatedAngle * c2;
+        } else {
+            calculatedAngle = 0.0;
+        }
+	} else if(blueCones[0] != dummy_cone) {                // Only one blue cone is detected
+        //std::cout << "Case 4" << std::endl;                       // For case 4 and 5, we get the distance of the cone (x), from 
+        coneCase = 4;                                               // the coresponding side (left or right) and then multiply that
+		if (m_isClockwiseKnown) {                                     // by a constant. Before that we check if we know the direction
+            if (m_isYellowLeft) {                                     // if yes the first block, if not we try to guess in the else block
+                calculatedAngle = width - blueCones[0].x;           // The rest is as above
+                calculatedAngle = calculatedAngle * c3;
+            } else {
+                calculatedAngle = blueCones[0].x;
+                calculatedAngle = negative * calculatedAngle * c3;
+            }
+		} else {
+            if (blueCones[0].x > midd_width) {
+                calculatedAngle = width - blueCones[0].x;
+                calculatedAngle = calculatedAngle * c4;
+            } else {
+                calculatedAngle = blueCones[0].x;
+                calculatedAngle = negative * calculatedAngle * c4;
+            } 
+        }
+	} else if(yellowCones[0] != dummy_cone) {           // Only one yellow cone is deteceted
+        //std::cout << "Case 5" << std::endl;
+        coneCase = 5;
+		if (m_isClockwiseKnown) {                                             // same as above
+            if (!m_isYellowLeft) {
+                calculatedAngle = width - yellowCones[0].x;
+                calculatedAngle = calculatedAngle * c3;
+            } else {
+                calculatedAngle = yellowCones[0].x;
+                calculatedAngle = negative * calculatedAngle * c3;
+            }
+		} else {
+            if (yellowCones[0].x > midd_width) {
+                calculatedAngle = width - yellowCones[0].x;
+                calculatedAngle = calculatedAngle * c4;
+            } else {
+                calculatedAngle = yellowCones[0].x;
+                calculatedAngle = negative * calculatedAngle * c4;
+            }
+            
+        }
+	} else {                // No cone is detected
+        //std::cout << "Case 6" << std::endl;
+        coneCase = 6;
+        calculatedAngle = 0.0;                                                  // if no cones are detected, just go straight the head and hope for the best
+    }
+    
+    return calculatedAngle;
+}
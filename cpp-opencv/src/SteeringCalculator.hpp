@@ -0,0 +1,23 @@
+#ifndef STEERINGCALCULATOR_HPP
+#define STEERINGCALCULATOR_HPP
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <cstdint>
+
+// Calculates the steering angle from the (at most two) blue and yellow cones found in the region of interest.
+// A cone that was not found is left as (0, 0). The angle is picked from one of six cases:
+//  1: cones of both colours, 2: two blue cones, 3: two yellow cones,
+//  4: one blue cone, 5: one yellow cone, 6: no cone at all.
+// The direction we are driving in is remembered between the frames, so use one instance per camera.
+class SteeringCalculator {
+   public:
+    float calculateAngle(std::array<cv::Point2f,2> blueCones, std::array<cv::Point2f,2> yellowCones, uint32_t &coneCase);
+
+   private:
+    bool m_isYellowLeft{false};      // Boolean value for if we have yellow cones on our left
+    bool m_isClockwiseKnown{false};  // Boolean value for if we know what direction we're going
+};
+
+#endif
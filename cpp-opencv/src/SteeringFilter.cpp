@@ -0,0 +1,86 @@
+#include "SteeringFilter.hpp"
+
+#include <algorithm>
+
+constexpr uint32_t SteeringFilter::CONFIRM_FRAMES;
+constexpr float SteeringFilter::ACCELERATION_NOISE;
+constexpr float SteeringFilter::RATE_DECAY;
+constexpr float SteeringFilter::UNCONFIRMED_PENALTY;
+// Both colours pin down the middle of the lane; a single cone only tells us roughly where one side is
+const std::array<float,5> SteeringFilter::MEASUREMENT_VARIANCE{{0.03f * 0.03f, 0.05f * 0.05f, 0.05f * 0.05f, 0.08f * 0.08f, 0.08f * 0.08f}};
+
+float SteeringFilter::update(float measuredAngle, uint32_t coneCase, float dt) noexcept {
+    // Frame intervals outside of this range are glitches in the time stamps
+    dt = std::min(std::max(dt, 0.001f), 0.5f);
+
+    if ((coneCase < 1) || (coneCase > 5)) {
+        // No cones: the measured angle is a placeholder, so only carry the estimate on
+        if (State::Initial != m_state) {
+            predict(dt);
+            m_rate *= RATE_DECAY;
+            m_state = State::Dropout;
+        }
+        return m_angle;
+    }
+
+    const float variance{MEASUREMENT_VARIANCE[coneCase - 1]};
+    if (State::Initial == m_state) {
+        m_angle = measuredAngle;
+        m_rate = 0.0f;
+        m_p00 = variance;
+        m_p01 = 0.0f;
+        m_p11 = 1.0f;
+        m_case = coneCase;
+        m_state = State::Tracking;
+        return m_angle;
+    }
+
+    predict(dt);
+    if ((coneCase == m_case) || (variance <= MEASUREMENT_VARIANCE[m_case - 1])) {
+        // Same case or more cones than before
+        m_case = coneCase;
+        m_candidateFrames = 0;
+        m_state = State::Tracking;
+        correct(measuredAngle, variance);
+    } else {
+        // Fewer cones than before; could be a cone flickering out of view
+        m_candidateFrames = (coneCase == m_candidateCase) ? m_candidateFrames + 1 : 1;
+        m_candidateCase = coneCase;
+        if (m_candidateFrames >= CONFIRM_FRAMES) {
+            m_case = coneCase;
+            m_candidateFrames = 0;
+            m_state = State::Tracking;
+            correct(measuredAngle, variance);
+        } else {
+            m_state = State::Confirming;
+            correct(measuredAngle, variance * UNCONFIRMED_PENALTY);
+        }
+    }
+    return m_angle;
+}
+
+void SteeringFilter::reset() noexcept {
+    *this = SteeringFilter{};
+}
+
+void SteeringFilter::predict(float dt) noexcept {
+    // Constant rate model: the angular acceleration is white noise
+    const float q{ACCELERATION_NOISE * ACCELERATION_NOISE};
+    const float dt2{dt * dt};
+    m_angle += m_rate * dt;
+    m_p00 += 2.0f * dt * m_p01 + dt2 * m_p11 + q * dt2 * dt2 / 4.0f;
+    m_p01 += dt * m_p11 + q * dt2 * dt / 2.0f;
+    m_p11 += q * dt2;
+}
+
+void SteeringFilter::correct(float measuredAngle, float variance) noexcept {
+    const float innovation{measuredAngle - m_angle};
+    const float s{m_p00 + variance};
+    const float k0{m_p00 / s};
+    const float k1{m_p01 / s};
+    m_angle += k0 * innovation;
+    m_rate += k1 * innovation;
+    m_p11 -= k1 * m_p01;
+    m_p01 *= (1.0f - k0);
+    m_p00 *= (1.0f - k0);
+}
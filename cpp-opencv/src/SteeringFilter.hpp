@@ -0,0 +1,57 @@
+#ifndef STEERINGFILTER_HPP
+#define STEERINGFILTER_HPP
+
+#include <array>
+#include <cstdint>
+
+// Smooths the per-frame steering angles of the SteeringCalculator over time. A Kalman filter tracks
+// the angle and its rate of change; how much a measurement is trusted depends on the case it was
+// calculated with. A state machine adds hysteresis on the case transitions:
+//  - switching to a case with more cones is accepted right away,
+//  - switching to a case with fewer cones has to be seen CONFIRM_FRAMES times in a row; until then,
+//    its measurements only nudge the estimate,
+//  - without any cones (case 6), the previous estimate is carried on while its rate decays.
+// Every update takes constant time and allocates nothing.
+class SteeringFilter {
+   public:
+    enum class State : uint8_t { Initial, Tracking, Confirming, Dropout };
+
+   public:
+    // Returns the filtered angle after the measurement of the frame that arrived dt seconds after the previous one
+    float update(float measuredAngle, uint32_t coneCase, float dt) noexcept;
+    void reset() noexcept;
+
+    float angle() const noexcept { return m_angle; }
+    float rate() const noexcept { return m_rate; }
+    State state() const noexcept { return m_state; }
+
+   private:
+    void predict(float dt) noexcept;
+    void correct(float measuredAngle, float variance) noexcept;
+
+   private:
+    // Frames a case with fewer cones has to be seen before it is trusted
+    static constexpr uint32_t CONFIRM_FRAMES{3};
+    // Standard deviation of the angular acceleration (rad/s^2) of the process model
+    static constexpr float ACCELERATION_NOISE{4.0f};
+    // Decay of the rate per frame without cones
+    static constexpr float RATE_DECAY{0.8f};
+    // Measurements of an unconfirmed case have this many times the variance of a confirmed one
+    static constexpr float UNCONFIRMED_PENALTY{25.0f};
+    // Variance of the measured angle for case 1..5
+    static const std::array<float,5> MEASUREMENT_VARIANCE;
+
+    State m_state{State::Initial};
+    uint32_t m_case{0};           // Last confirmed case
+    uint32_t m_candidateCase{0};  // Case with fewer cones waiting for its confirmation
+    uint32_t m_candidateFrames{0};
+
+    float m_angle{0.0f};
+    float m_rate{0.0f};
+    // Covariance of angle and rate
+    float m_p00{0.0f};
+    float m_p01{0.0f};
+    float m_p11{0.0f};
+};
+
+#endif
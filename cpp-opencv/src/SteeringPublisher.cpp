@@ -0,0 +1,71 @@
+#include "SteeringPublisher.hpp"
+#include "opendlv-standard-message-set.hpp"
+#include "Trace.hpp"
+
+SteeringPublisher::SteeringPublisher(cluon::OD4Session &od4, uint32_t senderStamp)
+    : m_od4(od4)
+    , m_senderStamp(senderStamp) {
+    m_thread = std::thread(&SteeringPublisher::run, this);
+}
+
+SteeringPublisher::~SteeringPublisher() {
+    {
+        std::lock_guard<std::mutex> lck(m_wakeUpMutex);
+        m_running.store(false);
+    }
+    m_wakeUp.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool SteeringPublisher::publish(float groundSteering, const cluon::data::TimeStamp &captureTime) noexcept {
+    const uint64_t head{m_head.load(std::memory_order_relaxed)};
+    if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+        // The sending thread is behind; never wait for it.
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    SteeringSample &sample = m_ring[head & (CAPACITY - 1)];
+    sample.groundSteering = groundSteering;
+    sample.captureTime = captureTime;
+    // Sequentially consistent together with m_sleeping: either the sender sees the new head before it
+    // goes to sleep, or we see that it sleeps. Only then is the mutex taken, which the sender holds only
+    // while it checks for new samples, never while it sends.
+    m_head.store(head + 1, std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_seq_cst)) {
+        { std::lock_guard<std::mutex> lck(m_wakeUpMutex); }
+        m_wakeUp.notify_one();
+    }
+    return true;
+}
+
+void SteeringPublisher::run() noexcept {
+    trace::nameThread("publisher");
+    opendlv::proxy::GroundSteeringRequest gsr;
+    uint64_t tail{m_tail.load(std::memory_order_relaxed)};
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lck(m_wakeUpMutex);
+            m_sleeping.store(true, std::memory_order_seq_cst);
+            m_wakeUp.wait(lck, [this, tail]{
+                return !m_running.load() || (m_head.load(std::memory_order_seq_cst) != tail);
+            });
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+        const uint64_t head{m_head.load(std::memory_order_acquire)};
+        if (head == tail && !m_running.load()) {
+            break;
+        }
+        for (; tail != head; tail++) {
+            const SteeringSample sample = m_ring[tail & (CAPACITY - 1)];
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            TRACE_SPAN("send");
+            gsr.groundSteering(sample.groundSteering);
+            // OD4Session::send sets the envelope's sent time stamp right before serialising.
+            m_od4.send(gsr, sample.captureTime, m_senderStamp);
+            m_sent.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef STEERINGPUBLISHER_HPP
+#define STEERINGPUBLISHER_HPP
+
+#include "cluon-complete.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// A computed steering angle together with the time point when the frame it
+// was computed from was captured (the time stamp of the shared memory area).
+struct SteeringSample {
+    float groundSteering{0.0f};
+    cluon::data::TimeStamp captureTime{};
+};
+
+// Publishes the computed steering angles as opendlv.proxy.GroundSteeringRequest
+// to an OD4Session. The frame loop only copies a SteeringSample into a fixed
+// size single-producer/single-consumer ring; serialising and sending happens
+// on a dedicated thread, so the frame loop never allocates or waits on the
+// network. Each envelope carries the capture time as sampleTimeStamp and the
+// time point of sending as sent; hence, sent - sampleTimeStamp is the
+// capture-to-output latency that downstream consumers can compensate for.
+class SteeringPublisher {
+   private:
+    SteeringPublisher(const SteeringPublisher &) = delete;
+    SteeringPublisher(SteeringPublisher &&)      = delete;
+    SteeringPublisher &operator=(const SteeringPublisher &) = delete;
+    SteeringPublisher &operator=(SteeringPublisher &&) = delete;
+
+   public:
+    SteeringPublisher(cluon::OD4Session &od4, uint32_t senderStamp);
+    ~SteeringPublisher();
+
+    // Called from the frame loop; returns false when the ring is full and the sample was dropped.
+    bool publish(float groundSteering, const cluon::data::TimeStamp &captureTime) noexcept;
+
+    uint32_t senderStamp() const noexcept { return m_senderStamp; }
+    uint64_t numberOfSentSamples() const noexcept { return m_sent.load(std::memory_order_relaxed); }
+    uint64_t numberOfDroppedSamples() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+   private:
+    void run() noexcept;
+
+   private:
+    // Power of two to wrap the indices with a mask.
+    static constexpr uint64_t CAPACITY{16};
+
+    cluon::OD4Session &m_od4;
+    const uint32_t m_senderStamp;
+
+    std::array<SteeringSample, CAPACITY> m_ring{};
+    std::atomic<uint64_t> m_head{0}; // Written by the frame loop only.
+    std::atomic<uint64_t> m_tail{0}; // Written by the sending thread only.
+
+    std::atomic<uint64_t> m_sent{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::atomic<bool> m_running{true};
+    // Set by the sending thread while it waits for samples; the frame loop only wakes it up then.
+    std::atomic<bool> m_sleeping{false};
+    std::mutex m_wakeUpMutex{};
+    std::condition_variable m_wakeUp{};
+    std::thread m_thread{};
+};
+
+#endif
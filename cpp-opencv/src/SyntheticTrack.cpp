@@ -0,0 +1,137 @@
+#include "SyntheticTrack.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cmath>
+
+constexpr float SyntheticTrack::ROI_TOP;
+constexpr float SyntheticTrack::ROI_HEIGHT;
+
+namespace {
+    // Dimensions in meters of the miniature car and its track
+    const float CAMERA_HEIGHT{0.12f};
+    const float TRACK_WIDTH{0.6f};
+    const float CONE_HEIGHT{0.06f};
+    const float CONE_SPACING{0.35f};
+    const float WHEELBASE{0.3f};
+    // How far the car moves per frame and how the curvature (1/m) of the track changes
+    const float SPEED{0.02f};
+    const float MAX_CURVATURE{0.5f};
+    const float CURVATURE_PERIOD{400.0f};
+    const float PI{3.14159265f};
+    const uint32_t CONES_PER_SIDE{8};
+
+    // Colours (BGRA) that fall in the middle of the microservice's blue and yellow HSV ranges
+    const cv::Scalar BLUE_CONE{180, 60, 20, 255};
+    const cv::Scalar YELLOW_CONE{80, 190, 235, 255};
+    const cv::Scalar ROAD{95, 90, 90, 255};
+    const cv::Scalar SKY{190, 175, 160, 255};
+}
+
+SyntheticTrack::SyntheticTrack(uint32_t width, uint32_t height, uint32_t seed)
+    : m_width(width)
+    , m_height(height)
+    , m_focalLength(0.8f * static_cast<float>(width))
+    , m_horizon(0.5f * static_cast<float>(height))
+    , m_roiTop(ROI_TOP / 480.0f * static_cast<float>(height))
+    , m_roiBottom((ROI_TOP + ROI_HEIGHT) / 480.0f * static_cast<float>(height))
+    , m_random(seed) {
+}
+
+void SyntheticTrack::render(uint32_t frameNumber, SyntheticFrame &frame) {
+    const int W{static_cast<int>(m_width)};
+    const int H{static_cast<int>(m_height)};
+    frame.image.create(H, W, CV_8UC4);
+    frame.image.setTo(ROAD);
+    frame.image(cv::Rect(0, 0, W, static_cast<int>(m_horizon))).setTo(SKY);
+
+    // The track bends slowly left and right; the lateral centre at distance d is curvature * d^2 / 2
+    const float curvature{MAX_CURVATURE * std::sin(2.0f * PI * static_cast<float>(frameNumber) / CURVATURE_PERIOD)};
+    const float travelled{std::fmod(SPEED * static_cast<float>(frameNumber), CONE_SPACING)};
+    const float yellowSide{m_yellowOnLeft ? 1.0f : -1.0f};
+
+    frame.blueCones = std::array<cv::Point2f,2>{};
+    frame.yellowCones = std::array<cv::Point2f,2>{};
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    // Draw from far to near so that the nearer cones cover the ones behind them
+    for (uint32_t i{CONES_PER_SIDE}; i-- > 0;) {
+        const float distance{0.3f + CONE_SPACING * static_cast<float>(i) - travelled};
+        const float centre{curvature * distance * distance / 2.0f};
+        const cv::Point2f yellow = drawCone(frame.image, distance, centre + yellowSide * TRACK_WIDTH / 2.0f, YELLOW_CONE, uniform(m_random) < m_dropoutProbability);
+        const cv::Point2f blue = drawCone(frame.image, distance, centre - yellowSide * TRACK_WIDTH / 2.0f, BLUE_CONE, uniform(m_random) < m_dropoutProbability);
+        keepNearest(yellow, frame.yellowCones);
+        keepNearest(blue, frame.blueCones);
+    }
+
+    // Lighting: a global gain changing over time and a shadow band moving across the road
+    const double gain{1.0 + m_lightingVariation * std::sin(2.0 * static_cast<double>(PI) * frameNumber / 150.0)};
+    frame.image.convertTo(frame.image, -1, gain, 0.0);
+    const int shadowWidth{W / 5};
+    const int shadowX{static_cast<int>((frameNumber * 7) % static_cast<uint32_t>(W + shadowWidth)) - shadowWidth};
+    const cv::Rect shadow{cv::Rect(shadowX, 0, shadowWidth, H) & cv::Rect(0, 0, W, H)};
+    if (shadow.area() > 0) {
+        cv::Mat band = frame.image(shadow);
+        band.convertTo(band, -1, 1.0 - m_lightingVariation, 0.0);
+    }
+
+    if (m_noiseSigma > 0.0) {
+        m_noise.create(H, W, CV_16SC4);
+        cv::randn(m_noise, cv::Scalar::all(0.0), cv::Scalar::all(m_noiseSigma));
+        cv::add(frame.image, m_noise, frame.image, cv::noArray(), CV_8UC4);
+    }
+
+    // The ground truth follows the curvature at the car; the expected angle uses the cones in the
+    // coordinates of the 640x480 frames that calculateAngle was written for
+    frame.groundSteering = std::atan(WHEELBASE * curvature);
+    std::array<cv::Point2f,2> blueCones{frame.blueCones};
+    std::array<cv::Point2f,2> yellowCones{frame.yellowCones};
+    const float SCALE_X{640.0f / static_cast<float>(m_width)};
+    const float SCALE_Y{480.0f / static_cast<float>(m_height)};
+    for (auto *cones : {&blueCones, &yellowCones}) {
+        for (auto &cone : *cones) {
+            cone.x *= SCALE_X;
+            cone.y *= SCALE_Y;
+        }
+    }
+    frame.expectedAngle = m_steering.calculateAngle(blueCones, yellowCones, frame.coneCase);
+}
+
+cv::Point2f SyntheticTrack::drawCone(cv::Mat &image, float distance, float lateral, const cv::Scalar &color, bool dropped) {
+    cv::Point2f centroid;
+    if (distance < 0.1f) {
+        return centroid;
+    }
+    const float x{0.5f * static_cast<float>(m_width) - m_focalLength * lateral / distance};
+    const float y{m_horizon + m_focalLength * CAMERA_HEIGHT / distance};
+    const float h{m_focalLength * CONE_HEIGHT / distance};
+    const float w{0.7f * h};
+    // Only cones standing completely inside the frame are drawn
+    if ((x - w / 2.0f < 0.0f) || (x + w / 2.0f >= static_cast<float>(m_width)) || (y >= static_cast<float>(m_height))) {
+        return centroid;
+    }
+    if (!dropped) {
+        const cv::Point corners[3]{cv::Point(static_cast<int>(x - w / 2.0f), static_cast<int>(y)),
+                                   cv::Point(static_cast<int>(x + w / 2.0f), static_cast<int>(y)),
+                                   cv::Point(static_cast<int>(x), static_cast<int>(y - h))};
+        cv::fillConvexPoly(image, corners, 3, color);
+        // The centroid of a triangle is the mean of its corners; only cones completely inside the region of interest are expected
+        if ((y - h >= m_roiTop) && (y < m_roiBottom)) {
+            centroid = cv::Point2f(x, y - h / 3.0f - m_roiTop);
+        }
+    }
+    return centroid;
+}
+
+void SyntheticTrack::keepNearest(const cv::Point2f &cone, std::array<cv::Point2f,2> &cones) const noexcept {
+    const cv::Point2f none;
+    if (cone == none) {
+        return;
+    }
+    // Nearer cones are further down in the image
+    if ((cones[0] == none) || (cone.y > cones[0].y)) {
+        cones[1] = cones[0];
+        cones[0] = cone;
+    } else if ((cones[1] == none) || (cone.y > cones[1].y)) {
+        cones[1] = cone;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef SYNTHETICTRACK_HPP
+#define SYNTHETICTRACK_HPP
+
+#include "SteeringCalculator.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+// One rendered frame together with what the microservice is expected to find in it
+struct SyntheticFrame {
+    cv::Mat image{};                        // BGRA pixels, like the frames in the shared memory area
+    std::array<cv::Point2f,2> blueCones{};  // Centroids of the two nearest visible cones in region-of-interest coordinates, (0, 0) if missing
+    std::array<cv::Point2f,2> yellowCones{};
+    float groundSteering{0.0f};             // Steering that follows the track, i.e. what a recording would contain
+    float expectedAngle{0.0f};              // What calculateAngle returns for the cones above
+    uint32_t coneCase{0};                   // Which of the six cases that angle was calculated with
+};
+
+// Renders frames of a winding track lined with blue and yellow cones as seen by the car's camera.
+// The track curvature changes slowly over the frames, cones randomly drop out to produce all six
+// cases, and the lighting and sensor noise vary. Rendering with the same seed gives the same frames.
+class SyntheticTrack {
+   public:
+    // Row where the region of interest starts and its height, at the 480 rows the microservice crops for
+    static constexpr float ROI_TOP{265.0f};
+    static constexpr float ROI_HEIGHT{140.0f};
+
+   public:
+    SyntheticTrack(uint32_t width, uint32_t height, uint32_t seed);
+
+    void yellowOnLeft(bool yellowOnLeft) noexcept { m_yellowOnLeft = yellowOnLeft; }
+    void noise(double sigma) noexcept { m_noiseSigma = sigma; }
+    void lightingVariation(double amount) noexcept { m_lightingVariation = amount; }
+    void dropoutProbability(double probability) noexcept { m_dropoutProbability = probability; }
+
+    // Renders the given frame into frame.image, reusing its pixel buffer when it already has the right size
+    void render(uint32_t frameNumber, SyntheticFrame &frame);
+
+   private:
+    // Draws one cone standing on the ground at the given distance and lateral offset (positive to the left);
+    // returns its centroid in the image, or (0, 0) if it is not visible
+    cv::Point2f drawCone(cv::Mat &image, float distance, float lateral, const cv::Scalar &color, bool dropped);
+    // Keeps the two cones nearest to the car that lie inside the region of interest
+    void keepNearest(const cv::Point2f &cone, std::array<cv::Point2f,2> &cones) const noexcept;
+
+   private:
+    const uint32_t m_width;
+    const uint32_t m_height;
+    const float m_focalLength;
+    const float m_horizon;
+    const float m_roiTop;
+    const float m_roiBottom;
+
+    bool m_yellowOnLeft{false};
+    double m_noiseSigma{4.0};
+    double m_lightingVariation{0.2};
+    double m_dropoutProbability{0.15};
+
+    std::mt19937 m_random;
+    cv::Mat m_noise{};
+    // The expected angle depends on the direction seen in the previous frames, just like in the microservice
+    SteeringCalculator m_steering{};
+};
+
+#endif
@@ -0,0 +1,106 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this once per test-runner!
+#include "catch.hpp"
+#include "FrameDropPolicy.hpp"
+
+#include <vector>
+
+namespace {
+constexpr int64_t PERIOD{50000};
+constexpr int64_t PROCESSING{5000};
+
+// Feeds the capture times to the policy; every frame is done PROCESSING after its capture
+void play(FrameDropPolicy &policy, const std::vector<int64_t> &captureTimes) {
+    for (auto captureTime : captureTimes) {
+        policy.onFrame(captureTime);
+        policy.onProcessed(captureTime + PROCESSING);
+    }
+}
+
+std::vector<int64_t> steadyStream(uint32_t frames) {
+    std::vector<int64_t> captureTimes;
+    for (uint32_t i{0}; i < frames; i++) {
+        captureTimes.push_back(1000000 + i * PERIOD);
+    }
+    return captureTimes;
+}
+}
+
+TEST_CASE("Test FrameDropPolicy with a steady stream.") {
+    FrameDropPolicy policy{true};
+    play(policy, steadyStream(200));
+    REQUIRE(200 == policy.processedFrames());
+    REQUIRE(PERIOD == policy.frameInterval());
+    REQUIRE(0 == policy.droppedFrames());
+    REQUIRE(0 == policy.producerGaps());
+    REQUIRE_FALSE(policy.degraded());
+}
+
+TEST_CASE("Test FrameDropPolicy with one frame captured early or late.") {
+    for (int64_t jitter : std::vector<int64_t>{-PERIOD / 2, -20000, -5000, 5000, 20000, PERIOD / 2}) {
+        auto captureTimes = steadyStream(200);
+        captureTimes[100] += jitter;
+        FrameDropPolicy policy{true};
+        play(policy, captureTimes);
+        REQUIRE(PERIOD == policy.frameInterval());
+        REQUIRE(0 == policy.droppedFrames());
+        REQUIRE(0 == policy.producerGaps());
+        REQUIRE_FALSE(policy.degraded());
+        REQUIRE(0 == policy.degradedFrames());
+    }
+}
+
+TEST_CASE("Test FrameDropPolicy with a burst of early frames.") {
+    // Three frames at a third of the period do not lock the estimate low
+    auto captureTimes = steadyStream(100);
+    const int64_t last{captureTimes.back()};
+    for (int64_t i{1}; i <= 3; i++) {
+        captureTimes.push_back(last + i * PERIOD / 3);
+    }
+    for (int64_t i{1}; i <= 100; i++) {
+        captureTimes.push_back(last + PERIOD + i * PERIOD);
+    }
+    FrameDropPolicy policy{true};
+    play(policy, captureTimes);
+    REQUIRE(PERIOD == policy.frameInterval());
+    REQUIRE(0 == policy.droppedFrames());
+    REQUIRE(0 == policy.producerGaps());
+    REQUIRE_FALSE(policy.degraded());
+}
+
+TEST_CASE("Test FrameDropPolicy with missing frames.") {
+    FrameDropPolicy policy{true};
+    auto captureTimes = steadyStream(100);
+    // Frames 40 and 41 never came, the producer was late
+    captureTimes.erase(captureTimes.begin() + 40, captureTimes.begin() + 42);
+    play(policy, captureTimes);
+    REQUIRE(PERIOD == policy.frameInterval());
+    REQUIRE(0 == policy.droppedFrames());
+    REQUIRE(2 == policy.producerGaps());
+    REQUIRE_FALSE(policy.degraded());
+
+    // A producer that slows down for good is followed
+    FrameDropPolicy slower{true};
+    play(slower, steadyStream(50));
+    std::vector<int64_t> slowerTimes;
+    for (int64_t i{1}; i <= 50; i++) {
+        slowerTimes.push_back(1000000 + 49 * PERIOD + 2 * i * PERIOD);
+    }
+    play(slower, slowerTimes);
+    REQUIRE(2 * PERIOD == slower.frameInterval());
+    REQUIRE(0 == slower.droppedFrames());
+    REQUIRE_FALSE(slower.degraded());
+
+    // After a while on time, processing takes 2.5 periods: two frames arrive while we are busy with every one
+    FrameDropPolicy slow{true};
+    play(slow, steadyStream(20));
+    for (int64_t i{1}; i <= 40; i++) {
+        const int64_t captureTime{1000000 + 19 * PERIOD + 3 * i * PERIOD};
+        slow.onFrame(captureTime);
+        slow.onProcessed(captureTime + 5 * PERIOD / 2);
+    }
+    REQUIRE(PERIOD == slow.frameInterval());
+    // The two frames before the first slow one are missing although we were idle
+    REQUIRE(78 == slow.droppedFrames());
+    REQUIRE(2 == slow.producerGaps());
+    REQUIRE(slow.degraded());
+}
@@ -0,0 +1,54 @@
+#include "catch.hpp"
+#include "AnnotatedFrame.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("Test FrameMailbox drops the older frame that was not taken.") {
+    FrameMailbox mailbox;
+    REQUIRE_FALSE(mailbox.take());
+
+    mailbox.back().captureTime = 1;
+    REQUIRE(mailbox.post());
+    mailbox.back().captureTime = 2;
+    // Frame 1 was never taken
+    REQUIRE_FALSE(mailbox.post());
+    REQUIRE(mailbox.take());
+    REQUIRE(2 == mailbox.front().captureTime);
+    REQUIRE_FALSE(mailbox.take());
+    REQUIRE(2 == mailbox.front().captureTime);
+
+    mailbox.back().captureTime = 3;
+    REQUIRE(mailbox.post());
+    REQUIRE(mailbox.take());
+    REQUIRE(3 == mailbox.front().captureTime);
+}
+
+TEST_CASE("Test FrameMailbox hands newer frames only to another thread.") {
+    FrameMailbox mailbox;
+    constexpr int64_t FRAMES{100000};
+    std::atomic<bool> done{false};
+    uint64_t dropped{0};
+    std::thread frameLoop([&mailbox, &done, &dropped]{
+        for (int64_t i{1}; i <= FRAMES; i++) {
+            mailbox.back().captureTime = i;
+            dropped += mailbox.post() ? 0 : 1;
+        }
+        done.store(true);
+    });
+
+    uint64_t taken{0};
+    int64_t previous{0};
+    bool increasing{true};
+    while (!done.load() || (previous < FRAMES)) {
+        if (mailbox.take()) {
+            increasing = increasing && (mailbox.front().captureTime > previous);
+            previous = mailbox.front().captureTime;
+            taken++;
+        }
+    }
+    frameLoop.join();
+    REQUIRE(increasing);
+    REQUIRE(FRAMES == previous);
+    REQUIRE(FRAMES == taken + dropped);
+}
@@ -0,0 +1,42 @@
+#include "catch.hpp"
+#include "FusedCones.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+StreamCones cones(uint32_t stream, int64_t captureTime) {
+    StreamCones c;
+    c.stream = stream;
+    c.captureTime = captureTime;
+    return c;
+}
+}
+
+TEST_CASE("Test FusedCones matches the frames by capture time.") {
+    FusedCones fused{std::vector<std::string>{"front", "left", "right"}};
+    for (int64_t t{0}; t < 20; t++) {
+        fused.post(cones(0, 1000000 + t * 50000));
+        fused.post(cones(1, 1000000 + t * 50000 + 10000));
+    }
+    // The third camera has seen one frame long ago
+    fused.post(cones(2, 100000));
+
+    std::vector<StreamCones> near;
+    fused.near(1000000 + 19 * 50000, 25000, near);
+    REQUIRE(2 == near.size());
+    REQUIRE(0 == near[0].stream);
+    REQUIRE(1000000 + 19 * 50000 == near[0].captureTime);
+    REQUIRE(1 == near[1].stream);
+    REQUIRE(1000000 + 19 * 50000 + 10000 == near[1].captureTime);
+
+    // A frame in between the frames of the other camera is answered with the closer one
+    fused.near(1000000 + 16 * 50000 + 30000, 25000, near);
+    REQUIRE(2 == near.size());
+    REQUIRE(1000000 + 17 * 50000 == near[0].captureTime);
+    REQUIRE(1000000 + 16 * 50000 + 10000 == near[1].captureTime);
+
+    std::vector<StreamCones> latest;
+    fused.latest(latest);
+    REQUIRE(3 == latest.size());
+}
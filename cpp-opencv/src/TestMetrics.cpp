@@ -0,0 +1,67 @@
+#include "catch.hpp"
+#include "Metrics.hpp"
+
+#include <string>
+
+namespace {
+// Number of times text occurs in s
+size_t occurrences(const std::string &s, const std::string &text) {
+    size_t n{0};
+    for (size_t i{s.find(text)}; std::string::npos != i; i = s.find(text, i + text.size())) {
+        n++;
+    }
+    return n;
+}
+}
+
+TEST_CASE("Test MetricsRegistry renders HELP and TYPE once per name with its samples together.") {
+    MetricsRegistry registry;
+    MetricCounter &case1 = registry.counter("frames_total", "Frames per case", "case=\"1\"");
+    MetricGauge &fps = registry.gauge("frame_rate", "Frames per second");
+    MetricCounter &case2 = registry.counter("frames_total", "Frames per case", "case=\"2\"");
+    case1.increment(3);
+    case2.increment();
+    fps.set(19.5);
+
+    const std::string text{registry.render()};
+    REQUIRE(1 == occurrences(text, "# HELP frames_total "));
+    REQUIRE(1 == occurrences(text, "# TYPE frames_total counter\n"));
+    REQUIRE(1 == occurrences(text, "# TYPE frame_rate gauge\n"));
+    REQUIRE(std::string::npos != text.find("# TYPE frames_total counter\nframes_total{case=\"1\"} 3\nframes_total{case=\"2\"} 1\n"));
+    REQUIRE(std::string::npos != text.find("# TYPE frame_rate gauge\nframe_rate 19.5\n"));
+}
+
+TEST_CASE("Test MetricsRegistry renders histograms with cumulative buckets and merged labels.") {
+    MetricsRegistry registry;
+    MetricHistogram &histogram = registry.histogram("latency_seconds", "Latency", {0.01, 0.05, 0.1}, "stage=\"detect\"");
+    for (double value : {0.005, 0.01, 0.02, 0.07, 0.5, 2.0}) {
+        histogram.observe(value);
+    }
+    MetricHistogram &unlabelled = registry.histogram("wait_seconds", "Waiting", {1.0});
+    unlabelled.observe(0.5);
+
+    const std::string text{registry.render()};
+    REQUIRE(std::string::npos != text.find("# TYPE latency_seconds histogram\n"
+                                           "latency_seconds_bucket{stage=\"detect\",le=\"0.01\"} 2\n"
+                                           "latency_seconds_bucket{stage=\"detect\",le=\"0.05\"} 3\n"
+                                           "latency_seconds_bucket{stage=\"detect\",le=\"0.1\"} 4\n"
+                                           "latency_seconds_bucket{stage=\"detect\",le=\"+Inf\"} 6\n"
+                                           "latency_seconds_sum{stage=\"detect\"} 2.605\n"
+                                           "latency_seconds_count{stage=\"detect\"} 6\n"));
+    REQUIRE(std::string::npos != text.find("wait_seconds_bucket{le=\"1\"} 1\n"
+                                           "wait_seconds_bucket{le=\"+Inf\"} 1\n"
+                                           "wait_seconds_sum 0.5\n"
+                                           "wait_seconds_count 1\n"));
+}
+
+TEST_CASE("Test MetricsRegistry samples its sampled metrics when rendering.") {
+    MetricsRegistry registry;
+    double value{1.0};
+    registry.gauge("queue_length", "Queued frames", "stream=\"left\"", [&value]{ return value; });
+    registry.counter("stream_frames_total", "Frames of a stream", "", []{ return 42.0; });
+    value = 7.0;
+
+    const std::string text{registry.render()};
+    REQUIRE(std::string::npos != text.find("# TYPE queue_length gauge\nqueue_length{stream=\"left\"} 7\n"));
+    REQUIRE(std::string::npos != text.find("# TYPE stream_frames_total counter\nstream_frames_total 42\n"));
+}
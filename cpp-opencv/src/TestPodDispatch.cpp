@@ -0,0 +1,108 @@
+#include "catch.hpp"
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+#include "opendlv-standard-message-set-pod.hpp"
+#include "PodDispatch.hpp"
+
+#include <string>
+#include <utility>
+
+namespace {
+using Subscribed = pod::MessageSet<opendlv::proxy::pod::GroundSteeringRequest,
+                                   opendlv::proxy::pod::AccelerationReading,
+                                   opendlv::proxy::pod::SwitchStateReading>;
+
+// Remembers the last message of each type and how often it was called
+struct Handler {
+    opendlv::proxy::pod::GroundSteeringRequest gsr{};
+    opendlv::proxy::pod::AccelerationReading acceleration{};
+    opendlv::proxy::pod::SwitchStateReading switchState{};
+    pod::EnvelopeView envelope{};
+    uint32_t calls{0};
+
+    void operator()(const opendlv::proxy::pod::GroundSteeringRequest &m, const pod::EnvelopeView &e) { gsr = m; envelope = e; calls++; }
+    void operator()(const opendlv::proxy::pod::AccelerationReading &m, const pod::EnvelopeView &e) { acceleration = m; envelope = e; calls++; }
+    void operator()(const opendlv::proxy::pod::SwitchStateReading &m, const pod::EnvelopeView &e) { switchState = m; envelope = e; calls++; }
+};
+
+// An OD4 datagram as libcluon sends it
+template <typename Message>
+std::string datagram(Message &message, uint32_t senderStamp, int64_t sampleTimeStamp) {
+    cluon::ToProtoVisitor proto;
+    message.accept(proto);
+    cluon::data::Envelope envelope;
+    envelope.dataType(Message::ID())
+            .serializedData(proto.encodedData())
+            .senderStamp(senderStamp)
+            .sent(cluon::time::fromMicroseconds(sampleTimeStamp + 2000))
+            .sampleTimeStamp(cluon::time::fromMicroseconds(sampleTimeStamp));
+    return cluon::serializeEnvelope(std::move(envelope));
+}
+
+pod::Dispatch dispatch(const std::string &data, Handler &handler) {
+    pod::EnvelopeView envelope;
+    REQUIRE(pod::decodeEnvelope(data.data(), data.size(), envelope));
+    return Subscribed::dispatch(envelope, handler);
+}
+}
+
+TEST_CASE("Test the pod decoders with the datagrams of libcluon.") {
+    Handler handler;
+
+    opendlv::proxy::GroundSteeringRequest gsr;
+    gsr.groundSteering(-0.125f);
+    REQUIRE(pod::Dispatch::HANDLED == dispatch(datagram(gsr, 7, 1584539301123456), handler));
+    REQUIRE(1 == handler.calls);
+    REQUIRE(-0.125f == Approx(handler.gsr.groundSteering));
+    REQUIRE(opendlv::proxy::GroundSteeringRequest::ID() == handler.envelope.dataType);
+    REQUIRE(7 == handler.envelope.senderStamp);
+    REQUIRE(1584539301123456 == handler.envelope.sampleTimeStamp);
+    REQUIRE(1584539301125456 == handler.envelope.sent);
+
+    opendlv::proxy::AccelerationReading acceleration;
+    acceleration.accelerationX(1.5f).accelerationY(-9.81f).accelerationZ(0.25f);
+    REQUIRE(pod::Dispatch::HANDLED == dispatch(datagram(acceleration, 0, 1000000), handler));
+    REQUIRE(2 == handler.calls);
+    REQUIRE(1.5f == Approx(handler.acceleration.accelerationX));
+    REQUIRE(-9.81f == Approx(handler.acceleration.accelerationY));
+    REQUIRE(0.25f == Approx(handler.acceleration.accelerationZ));
+
+    // Signed integers are zigzag encoded
+    opendlv::proxy::SwitchStateReading switchState;
+    switchState.state(-300);
+    REQUIRE(pod::Dispatch::HANDLED == dispatch(datagram(switchState, 1, 1000000), handler));
+    REQUIRE(3 == handler.calls);
+    REQUIRE(-300 == handler.switchState.state);
+}
+
+TEST_CASE("Test the pod decoders reject a truncated datagram.") {
+    opendlv::proxy::AccelerationReading acceleration;
+    acceleration.accelerationX(1.5f).accelerationY(-9.81f).accelerationZ(0.25f);
+    const std::string data{datagram(acceleration, 3, 1000000)};
+
+    pod::EnvelopeView envelope;
+    for (size_t size{0}; size < data.size(); size++) {
+        REQUIRE_FALSE(pod::decodeEnvelope(data.data(), size, envelope));
+    }
+
+    // An envelope whose payload ends in the middle of a field
+    pod::EnvelopeView cut;
+    REQUIRE(pod::decodeEnvelope(data.data(), data.size(), cut));
+    cut.payloadSize--;
+    Handler handler;
+    REQUIRE(pod::Dispatch::MALFORMED == Subscribed::dispatch(cut, handler));
+    REQUIRE(0 == handler.calls);
+}
+
+TEST_CASE("Test the pod dispatch leaves unsubscribed messages alone.") {
+    Handler handler;
+    opendlv::proxy::GroundSpeedRequest speed;
+    speed.groundSpeed(2.0f);
+    REQUIRE(pod::Dispatch::UNSUBSCRIBED == dispatch(datagram(speed, 0, 1000000), handler));
+
+    // An identifier that falls into the slot of a subscribed one
+    pod::EnvelopeView envelope;
+    envelope.dataType = static_cast<int32_t>(opendlv::proxy::GroundSteeringRequest::ID() + Subscribed::SLOTS);
+    REQUIRE(pod::Dispatch::UNSUBSCRIBED == Subscribed::dispatch(envelope, handler));
+    REQUIRE(0 == handler.calls);
+}
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "SteeringFilter.hpp"
+
+namespace {
+constexpr float DT{0.05f};
+
+// A filter that tracks the angle with both colours (case 1)
+SteeringFilter tracking(float angle) {
+    SteeringFilter filter;
+    for (uint32_t i{0}; i < 20; i++) {
+        filter.update(angle, 1, DT);
+    }
+    return filter;
+}
+}
+
+TEST_CASE("Test SteeringFilter starts with the first measurement with cones.") {
+    SteeringFilter filter;
+    REQUIRE(0.0f == Approx(filter.update(0.3f, 6, DT)));
+    REQUIRE(SteeringFilter::State::Initial == filter.state());
+    REQUIRE(0.2f == Approx(filter.update(0.2f, 2, DT)));
+    REQUIRE(SteeringFilter::State::Tracking == filter.state());
+}
+
+TEST_CASE("Test SteeringFilter confirms a case with fewer cones after three frames.") {
+    SteeringFilter filter{tracking(0.1f)};
+    REQUIRE(0.1f == Approx(filter.angle()).margin(0.001f));
+
+    // A single cone (case 4) only nudges the estimate until it has been seen three times in a row
+    filter.update(0.3f, 4, DT);
+    REQUIRE(SteeringFilter::State::Confirming == filter.state());
+    const float nudged{filter.angle()};
+    REQUIRE(nudged > 0.1f);
+    REQUIRE(nudged < 0.15f);
+    filter.update(0.3f, 4, DT);
+    REQUIRE(SteeringFilter::State::Confirming == filter.state());
+    filter.update(0.3f, 4, DT);
+    REQUIRE(SteeringFilter::State::Tracking == filter.state());
+
+    // Once confirmed, the measurements of the case are trusted fully
+    for (uint32_t i{0}; i < 20; i++) {
+        filter.update(0.3f, 4, DT);
+    }
+    REQUIRE(0.3f == Approx(filter.angle()).margin(0.01f));
+}
+
+TEST_CASE("Test SteeringFilter starts over confirming when the case flickers.") {
+    SteeringFilter filter{tracking(0.1f)};
+    filter.update(0.3f, 4, DT);
+    filter.update(0.3f, 4, DT);
+    // Both colours again: accepted right away, and the count for case 4 starts over
+    filter.update(0.1f, 1, DT);
+    REQUIRE(SteeringFilter::State::Tracking == filter.state());
+    filter.update(0.3f, 4, DT);
+    filter.update(0.3f, 4, DT);
+    REQUIRE(SteeringFilter::State::Confirming == filter.state());
+    // Another case with fewer cones starts over as well
+    filter.update(0.3f, 5, DT);
+    filter.update(0.3f, 5, DT);
+    REQUIRE(SteeringFilter::State::Confirming == filter.state());
+    filter.update(0.3f, 5, DT);
+    REQUIRE(SteeringFilter::State::Tracking == filter.state());
+}
+
+TEST_CASE("Test SteeringFilter carries the estimate on through a dropout.") {
+    // Turning in at 1 rad/s
+    SteeringFilter filter;
+    for (uint32_t i{0}; i < 40; i++) {
+        filter.update(static_cast<float>(i) * DT, 1, DT);
+    }
+    const float angle{filter.angle()};
+    const float rate{filter.rate()};
+    REQUIRE(1.0f == Approx(rate).margin(0.05f));
+
+    // Without cones, the measured angle is ignored and the rate decays
+    REQUIRE(angle + rate * DT == Approx(filter.update(-1.0f, 6, DT)));
+    REQUIRE(SteeringFilter::State::Dropout == filter.state());
+    REQUIRE(0.8f * rate == Approx(filter.rate()));
+    filter.update(-1.0f, 6, DT);
+    REQUIRE(angle + rate * DT + 0.8f * rate * DT == Approx(filter.angle()));
+    REQUIRE(0.8f * 0.8f * rate == Approx(filter.rate()));
+
+    // The cones are back
+    filter.update(angle + 2.0f * rate * DT, 1, DT);
+    REQUIRE(SteeringFilter::State::Tracking == filter.state());
+}
+
+TEST_CASE("Test SteeringFilter clamps the frame interval.") {
+    const SteeringFilter start{tracking(0.1f)};
+    // Glitches in the time stamps are taken as 1 ms and 500 ms
+    for (float dt : {0.0f, -1.0f, 0.0001f}) {
+        SteeringFilter glitch{start};
+        SteeringFilter clamped{start};
+        REQUIRE(clamped.update(0.3f, 1, 0.001f) == Approx(glitch.update(0.3f, 1, dt)));
+        REQUIRE(clamped.rate() == Approx(glitch.rate()));
+    }
+    for (float dt : {0.5f, 3.0f, 3600.0f}) {
+        SteeringFilter glitch{start};
+        SteeringFilter clamped{start};
+        REQUIRE(clamped.update(0.3f, 1, 0.5f) == Approx(glitch.update(0.3f, 1, dt)));
+        REQUIRE(clamped.rate() == Approx(glitch.rate()));
+    }
+}
@@ -0,0 +1,71 @@
+#include "ThresholdKernels.hpp"
+
+#if defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace kernels {
+
+alignas(16) const int8_t DEINTERLEAVE_HSV[3][3][16] = {
+    {{0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13}},
+    {{1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14}},
+    {{2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15}}};
+
+namespace {
+// Without branches; the compiler vectorises this for whatever the baseline instruction set is
+inline uint8_t inRange(const uint8_t *hsv, const HsvRange &range) {
+    return static_cast<uint8_t>(-static_cast<int32_t>(
+        (static_cast<uint8_t>(hsv[0] - range.low[0]) <= static_cast<uint8_t>(range.high[0] - range.low[0])) &
+        (static_cast<uint8_t>(hsv[1] - range.low[1]) <= static_cast<uint8_t>(range.high[1] - range.low[1])) &
+        (static_cast<uint8_t>(hsv[2] - range.low[2]) <= static_cast<uint8_t>(range.high[2] - range.low[2]))));
+}
+}
+
+void dualThresholdScalar(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB) {
+    for (size_t i{0}; i < pixels; i++, hsv += 3) {
+        maskA[i] = inRange(hsv, a);
+        maskB[i] = inRange(hsv, b);
+    }
+}
+
+}
+
+const std::vector<ThresholdKernel> &availableThresholdKernels() {
+    static const std::vector<ThresholdKernel> AVAILABLE{[]{
+        std::vector<ThresholdKernel> available{{"scalar", kernels::dualThresholdScalar}};
+#if defined(HAVE_THRESHOLD_SSE41)
+        if (__builtin_cpu_supports("sse4.1")) {
+            available.push_back({"sse4.1", kernels::dualThresholdSse41});
+        }
+#endif
+#if defined(HAVE_THRESHOLD_AVX2)
+        // Also checks that the operating system saves the AVX registers
+        if (__builtin_cpu_supports("avx2")) {
+            available.push_back({"avx2", kernels::dualThresholdAvx2});
+        }
+#endif
+#if defined(HAVE_THRESHOLD_NEON)
+#if defined(__arm__)
+        if (0 != (getauxval(AT_HWCAP) & HWCAP_NEON))
+#endif
+        {
+            // NEON is part of every AArch64 CPU
+            available.push_back({"neon", kernels::dualThresholdNeon});
+        }
+#endif
+        return available;
+    }()};
+    return AVAILABLE;
+}
+
+const ThresholdKernel &selectedThresholdKernel() {
+    // The variants are added in the order of preference
+    return availableThresholdKernels().back();
+}
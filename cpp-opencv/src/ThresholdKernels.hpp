@@ -0,0 +1,40 @@
+#ifndef THRESHOLDKERNELS_HPP
+#define THRESHOLDKERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Inclusive range of an HSV colour, like the low and high values of cv::inRange
+struct HsvRange {
+    uint8_t low[3];
+    uint8_t high[3];
+};
+
+// Thresholds interleaved HSV pixels against two colour ranges in one pass: mask[i] is 255 when
+// pixel i lies in the range and 0 otherwise, which is the same as two calls of cv::inRange.
+using DualThresholdFunction = void (*)(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB);
+
+// One instruction set variant of the kernel
+struct ThresholdKernel {
+    const char *name;
+    DualThresholdFunction function;
+};
+
+// The variants that this binary contains and the CPU supports, the portable one first
+const std::vector<ThresholdKernel> &availableThresholdKernels();
+// The fastest of them; chosen once via cpuid (x86) or the hardware capabilities (ARM)
+const ThresholdKernel &selectedThresholdKernel();
+
+// The variants themselves; each one that is not portable lives in its own file compiled for its instruction set.
+namespace kernels {
+    void dualThresholdScalar(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB);
+    void dualThresholdSse41(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB);
+    void dualThresholdAvx2(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB);
+    void dualThresholdNeon(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB);
+
+    // Byte shuffles that gather channel c of 16 interleaved pixels from the 16-byte block b of their 48 bytes
+    alignas(16) extern const int8_t DEINTERLEAVE_HSV[3][3][16];
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "ThresholdKernels.hpp"
+
+#include <immintrin.h>
+
+namespace kernels {
+
+namespace {
+// 0xFF for the bytes of x in [low, high]
+inline __m256i inRange(__m256i x, __m256i low, __m256i high) {
+    return _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(x, low), x), _mm256_cmpeq_epi8(_mm256_min_epu8(x, high), x));
+}
+
+// Byte shuffles only work within each 128 bit lane; hence, the low lane holds pixels 0..15 and the high lane pixels 16..31
+inline __m256i gather(const __m256i (&blocks)[3], const int8_t (&shuffles)[3][16]) {
+    return _mm256_or_si256(_mm256_or_si256(
+        _mm256_shuffle_epi8(blocks[0], _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[0])))),
+        _mm256_shuffle_epi8(blocks[1], _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[1]))))),
+        _mm256_shuffle_epi8(blocks[2], _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[2])))));
+}
+
+inline __m256i loadLanes(const __m128i *low, const __m128i *high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(low)), _mm_loadu_si128(high), 1);
+}
+}
+
+void dualThresholdAvx2(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB) {
+    __m256i lowA[3], highA[3], lowB[3], highB[3];
+    for (int c{0}; c < 3; c++) {
+        lowA[c] = _mm256_set1_epi8(static_cast<char>(a.low[c]));
+        highA[c] = _mm256_set1_epi8(static_cast<char>(a.high[c]));
+        lowB[c] = _mm256_set1_epi8(static_cast<char>(b.low[c]));
+        highB[c] = _mm256_set1_epi8(static_cast<char>(b.high[c]));
+    }
+
+    size_t i{0};
+    for (; i + 32 <= pixels; i += 32) {
+        const __m128i *in{reinterpret_cast<const __m128i*>(hsv + 3 * i)};
+        const __m256i blocks[3]{loadLanes(in, in + 3), loadLanes(in + 1, in + 4), loadLanes(in + 2, in + 5)};
+        const __m256i h{gather(blocks, DEINTERLEAVE_HSV[0])};
+        const __m256i s{gather(blocks, DEINTERLEAVE_HSV[1])};
+        const __m256i v{gather(blocks, DEINTERLEAVE_HSV[2])};
+        const __m256i inA{_mm256_and_si256(_mm256_and_si256(inRange(h, lowA[0], highA[0]), inRange(s, lowA[1], highA[1])), inRange(v, lowA[2], highA[2]))};
+        const __m256i inB{_mm256_and_si256(_mm256_and_si256(inRange(h, lowB[0], highB[0]), inRange(s, lowB[1], highB[1])), inRange(v, lowB[2], highB[2]))};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maskA + i), inA);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maskB + i), inB);
+    }
+    dualThresholdScalar(hsv + 3 * i, pixels - i, a, b, maskA + i, maskB + i);
+}
+
+}
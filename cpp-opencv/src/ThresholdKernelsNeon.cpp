@@ -0,0 +1,35 @@
+#include "ThresholdKernels.hpp"
+
+#include <arm_neon.h>
+
+namespace kernels {
+
+namespace {
+// 0xFF for the bytes of x in [low, high]
+inline uint8x16_t inRange(uint8x16_t x, uint8x16_t low, uint8x16_t high) {
+    return vandq_u8(vcgeq_u8(x, low), vcleq_u8(x, high));
+}
+}
+
+void dualThresholdNeon(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB) {
+    uint8x16_t lowA[3], highA[3], lowB[3], highB[3];
+    for (int c{0}; c < 3; c++) {
+        lowA[c] = vdupq_n_u8(a.low[c]);
+        highA[c] = vdupq_n_u8(a.high[c]);
+        lowB[c] = vdupq_n_u8(b.low[c]);
+        highB[c] = vdupq_n_u8(b.high[c]);
+    }
+
+    size_t i{0};
+    for (; i + 16 <= pixels; i += 16) {
+        // Loads and deinterleaves 16 pixels at once
+        const uint8x16x3_t pixel{vld3q_u8(hsv + 3 * i)};
+        const uint8x16_t inA{vandq_u8(vandq_u8(inRange(pixel.val[0], lowA[0], highA[0]), inRange(pixel.val[1], lowA[1], highA[1])), inRange(pixel.val[2], lowA[2], highA[2]))};
+        const uint8x16_t inB{vandq_u8(vandq_u8(inRange(pixel.val[0], lowB[0], highB[0]), inRange(pixel.val[1], lowB[1], highB[1])), inRange(pixel.val[2], lowB[2], highB[2]))};
+        vst1q_u8(maskA + i, inA);
+        vst1q_u8(maskB + i, inB);
+    }
+    dualThresholdScalar(hsv + 3 * i, pixels - i, a, b, maskA + i, maskB + i);
+}
+
+}
@@ -0,0 +1,45 @@
+#include "ThresholdKernels.hpp"
+
+#include <smmintrin.h>
+
+namespace kernels {
+
+namespace {
+// 0xFF for the bytes of x in [low, high]
+inline __m128i inRange(__m128i x, __m128i low, __m128i high) {
+    return _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(x, low), x), _mm_cmpeq_epi8(_mm_min_epu8(x, high), x));
+}
+
+inline __m128i gather(const __m128i (&blocks)[3], const int8_t (&shuffles)[3][16]) {
+    return _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(blocks[0], _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[0]))),
+        _mm_shuffle_epi8(blocks[1], _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[1])))),
+        _mm_shuffle_epi8(blocks[2], _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[2]))));
+}
+}
+
+void dualThresholdSse41(const uint8_t *hsv, size_t pixels, const HsvRange &a, const HsvRange &b, uint8_t *maskA, uint8_t *maskB) {
+    __m128i lowA[3], highA[3], lowB[3], highB[3];
+    for (int c{0}; c < 3; c++) {
+        lowA[c] = _mm_set1_epi8(static_cast<char>(a.low[c]));
+        highA[c] = _mm_set1_epi8(static_cast<char>(a.high[c]));
+        lowB[c] = _mm_set1_epi8(static_cast<char>(b.low[c]));
+        highB[c] = _mm_set1_epi8(static_cast<char>(b.high[c]));
+    }
+
+    size_t i{0};
+    for (; i + 16 <= pixels; i += 16) {
+        const __m128i *in{reinterpret_cast<const __m128i*>(hsv + 3 * i)};
+        const __m128i blocks[3]{_mm_loadu_si128(in), _mm_loadu_si128(in + 1), _mm_loadu_si128(in + 2)};
+        const __m128i h{gather(blocks, DEINTERLEAVE_HSV[0])};
+        const __m128i s{gather(blocks, DEINTERLEAVE_HSV[1])};
+        const __m128i v{gather(blocks, DEINTERLEAVE_HSV[2])};
+        const __m128i inA{_mm_and_si128(_mm_and_si128(inRange(h, lowA[0], highA[0]), inRange(s, lowA[1], highA[1])), inRange(v, lowA[2], highA[2]))};
+        const __m128i inB{_mm_and_si128(_mm_and_si128(inRange(h, lowB[0], highB[0]), inRange(s, lowB[1], highB[1])), inRange(v, lowB[2], highB[2]))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(maskA + i), inA);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(maskB + i), inB);
+    }
+    dualThresholdScalar(hsv + 3 * i, pixels - i, a, b, maskA + i, maskB + i);
+}
+
+}
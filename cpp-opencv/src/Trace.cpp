@@ -0,0 +1,185 @@
+#include "Trace.hpp"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+struct Event {
+    const char *name;
+    int64_t begin;  // Nanoseconds of the steady clock
+    int64_t end;
+    uint64_t frame;
+};
+
+// Written by its thread only; the trace writer reads the first size events
+struct ThreadBuffer {
+    std::unique_ptr<Event[]> events;
+    size_t capacity;
+    std::atomic<size_t> size{0};
+    std::atomic<uint64_t> dropped{0};
+    int64_t threadId;
+    std::string threadName;
+    uint64_t frame{0};
+
+    ThreadBuffer(size_t eventCapacity, int64_t id)
+        : events(new Event[eventCapacity])
+        , capacity(eventCapacity)
+        , threadId(id)
+        , threadName() {}
+};
+
+std::mutex g_mutex;
+// Buffers outlive their threads, so that spans of finished threads are written too
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+std::string g_file;
+size_t g_eventsPerThread{0};
+int64_t g_start{0};
+
+std::atomic<bool> g_flushRequested{false};
+std::atomic<bool> g_watching{false};
+std::thread g_watcher;
+
+// Spans of threads without a buffer
+std::atomic<uint64_t> g_unbuffered{0};
+
+thread_local ThreadBuffer *t_buffer{nullptr};
+
+// Allocates the buffer of the calling thread outside of any span; record() never allocates
+ThreadBuffer *createBuffer() {
+    if (nullptr == t_buffer) {
+        std::unique_ptr<ThreadBuffer> b{new ThreadBuffer(g_eventsPerThread, static_cast<int64_t>(::syscall(SYS_gettid)))};
+        std::lock_guard<std::mutex> lck(g_mutex);
+        g_buffers.push_back(std::move(b));
+        t_buffer = g_buffers.back().get();
+    }
+    return t_buffer;
+}
+
+void onSignal(int) {
+    g_flushRequested.store(true);
+}
+
+void write() {
+    std::lock_guard<std::mutex> lck(g_mutex);
+    std::ofstream out(g_file, std::ios::out | std::ios::trunc);
+    if (!out.good()) {
+        std::cerr << "trace: Failed to open '" << g_file << "'." << std::endl;
+        return;
+    }
+    const int32_t pid{static_cast<int32_t>(::getpid())};
+    uint64_t events{0};
+    uint64_t dropped{0};
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":0,\"args\":{\"name\":\"template-opencv\"}}";
+    for (const auto &b : g_buffers) {
+        if (!b->threadName.empty()) {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << b->threadId
+                << ",\"args\":{\"name\":\"" << b->threadName << "\"}}";
+        }
+        const size_t size{b->size.load(std::memory_order_acquire)};
+        for (size_t i{0}; i < size; i++) {
+            const Event &e = b->events[i];
+            // Complete events ("X") with microseconds since start
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << b->threadId
+                << ",\"ts\":" << static_cast<double>(e.begin - g_start) / 1000.0
+                << ",\"dur\":" << static_cast<double>(e.end - e.begin) / 1000.0
+                << ",\"args\":{\"frame\":" << e.frame << "}}";
+        }
+        events += size;
+        dropped += b->dropped.load(std::memory_order_relaxed);
+    }
+    out << "\n]}\n";
+    std::clog << "trace: Wrote " << events << " spans to '" << g_file << "'";
+    if (dropped > 0) {
+        std::clog << "; " << dropped << " did not fit into the buffers";
+    }
+    const uint64_t unbuffered{g_unbuffered.load(std::memory_order_relaxed)};
+    if (unbuffered > 0) {
+        std::clog << "; " << unbuffered << " came from threads that did not call trace::nameThread()";
+    }
+    std::clog << "." << std::endl;
+}
+}
+
+void start(const std::string &file, size_t eventsPerThread) {
+    {
+        std::lock_guard<std::mutex> lck(g_mutex);
+        g_file = file;
+        g_eventsPerThread = eventsPerThread;
+        g_start = now();
+    }
+    createBuffer();
+    g_enabled.store(true);
+
+    // Writing a file is not allowed in a signal handler; a watcher does it instead
+    std::signal(SIGUSR1, onSignal);
+    g_watching.store(true);
+    g_watcher = std::thread([]{
+        while (g_watching.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (g_flushRequested.exchange(false)) {
+                write();
+            }
+        }
+    });
+}
+
+void stop() {
+    if (!g_enabled.exchange(false)) {
+        return;
+    }
+    g_watching.store(false);
+    if (g_watcher.joinable()) {
+        g_watcher.join();
+    }
+    std::signal(SIGUSR1, SIG_DFL);
+    write();
+}
+
+void nameThread(const char *name) {
+    if (enabled()) {
+        ThreadBuffer *b{createBuffer()};
+        std::lock_guard<std::mutex> lck(g_mutex);
+        b->threadName = name;
+    }
+}
+
+void setFrame(uint64_t frame) noexcept {
+    if (enabled() && (nullptr != t_buffer)) {
+        t_buffer->frame = frame;
+    }
+}
+
+int64_t now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char *name, int64_t begin, int64_t end) noexcept {
+    ThreadBuffer *b{t_buffer};
+    if (nullptr == b) {
+        g_unbuffered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const size_t size{b->size.load(std::memory_order_relaxed)};
+    if (size < b->capacity) {
+        b->events[size] = Event{name, begin, end, b->frame};
+        b->size.store(size + 1, std::memory_order_release);
+    } else {
+        b->dropped.store(b->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+}
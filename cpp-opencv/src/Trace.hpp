@@ -0,0 +1,59 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Opt-in timeline of what each thread did when: TRACE_SPAN("name") records the begin and end of the
+// enclosing scope together with the thread and the frame the thread is working on. Every thread writes
+// into its own buffer without locks; a full buffer drops further spans. The buffers are allocated by
+// start() for the calling thread and by nameThread() for the others, never inside a span: spans of a
+// thread that did not name itself are dropped and counted. The buffers are
+// written as a Chrome trace (JSON) that opens in Perfetto or chrome://tracing, at stop() and whenever
+// the process receives SIGUSR1. While tracing is off, a span costs one relaxed load.
+namespace trace {
+    // Starts recording; up to eventsPerThread spans are kept per thread
+    void start(const std::string &file, size_t eventsPerThread = 1 << 17);
+    // Stops recording and writes the file
+    void stop();
+
+    // Name of the calling thread in the timeline; allocates its buffer, so call it when the thread starts
+    void nameThread(const char *name);
+    // Frame sequence number attached to the following spans of the calling thread
+    void setFrame(uint64_t frame) noexcept;
+
+    extern std::atomic<bool> g_enabled;
+    inline bool enabled() noexcept { return g_enabled.load(std::memory_order_relaxed); }
+    int64_t now() noexcept;
+    void record(const char *name, int64_t begin, int64_t end) noexcept;
+
+    // name must be a string literal (or otherwise live until the trace is written)
+    class Span {
+       private:
+        Span(const Span &) = delete;
+        Span(Span &&)      = delete;
+        Span &operator=(const Span &) = delete;
+        Span &operator=(Span &&) = delete;
+
+       public:
+        explicit Span(const char *name) noexcept
+            : m_name(name)
+            , m_begin(enabled() ? now() : 0) {}
+        ~Span() {
+            if (0 != m_begin) {
+                record(m_name, m_begin, now());
+            }
+        }
+
+       private:
+        const char *m_name;
+        const int64_t m_begin;
+    };
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(name) trace::Span TRACE_CONCAT(traceSpan, __COUNTER__){name}
+
+#endif
@@ -0,0 +1,46 @@
+#include "WorkerPool.hpp"
+#include "Trace.hpp"
+
+#include <utility>
+
+WorkerPool::WorkerPool(uint32_t numberOfThreads) {
+    for (uint32_t i{0}; i < ((0 == numberOfThreads) ? 1 : numberOfThreads); i++) {
+        m_threads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_running = false;
+    }
+    m_wakeUp.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_wakeUp.notify_one();
+}
+
+void WorkerPool::run() {
+    trace::nameThread("worker");
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lck(m_mutex);
+            m_wakeUp.wait(lck, [this]{ return !m_running || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                break;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed number of threads that run the submitted jobs in the order of submission. The jobs still
+// queued when the pool is destroyed are run before its threads end.
+class WorkerPool {
+   private:
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool(WorkerPool &&)      = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+
+   public:
+    explicit WorkerPool(uint32_t numberOfThreads);
+    ~WorkerPool();
+
+    void submit(std::function<void()> job);
+    uint32_t numberOfThreads() const noexcept { return static_cast<uint32_t>(m_threads.size()); }
+
+   private:
+    void run();
+
+   private:
+    std::mutex m_mutex{};
+    std::condition_variable m_wakeUp{};
+    std::deque<std::function<void()>> m_jobs{};
+    bool m_running{true};
+    std::vector<std::thread> m_threads{};
+};
+
+#endif
@@ -0,0 +1,240 @@
+// Include the single-file, header-only middleware libcluon to create high-performance microservices
+#include "cluon-complete.hpp"
+// Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
+#include "opendlv-standard-message-set.hpp"
+#include "SyntheticTrack.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------ Function declaration -------------------
+pid_t startMicroservice(const std::string &service, const std::vector<std::string> &arguments, bool verbose);
+void stopMicroservice(pid_t pid, cluon::SharedMemory &sharedMemory);
+std::vector<SyntheticFrame> renderTrack(uint32_t width, uint32_t height, uint32_t frames);
+void printDistribution(const std::string &label, std::vector<int64_t> &latencies);
+//------------------ Function declaration -------------------
+
+// The harness plays the camera: it writes frames of a synthetic cone track into a shared memory area,
+// stamps them with their capture time and notifies the microservice under test. The frames have cones
+// in all six cases, so that the latency covers the detection and steering paths of a real drive. The steering requests coming
+// back over OD4 carry that capture time as sampleTimeStamp, which gives the capture-to-output latency.
+int32_t main(int32_t argc, char **argv) {
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 == commandlineArguments.count("service")) {
+        std::cerr << argv[0] << " measures the capture-to-output latency of the steering microservice." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --service=<path to template-opencv> [--cid=<OD4 session>] [--name=<shared memory area>] [--width=<w>] [--height=<h>] [--freq=<Hz>] [--frames=<n>] [--warmup=<n>] [--load=<threads>] [--id=<sender stamp>] [--verbose]" << std::endl;
+        std::cerr << "         --service: microservice to start against the synthetic frames" << std::endl;
+        std::cerr << "         --cid:     CID of the OD4Session used for the measurement (default: 111)" << std::endl;
+        std::cerr << "         --name:    name of the shared memory area to create (default: latency)" << std::endl;
+        std::cerr << "         --width:   width of the frame (default: 640)" << std::endl;
+        std::cerr << "         --height:  height of the frame (default: 480)" << std::endl;
+        std::cerr << "         --freq:    frame rate of the producer (default: 20)" << std::endl;
+        std::cerr << "         --frames:  number of measured frames (default: 1000)" << std::endl;
+        std::cerr << "         --warmup:  number of frames sent before measuring (default: 50)" << std::endl;
+        std::cerr << "         --load:    number of busy threads to put the CPU under load (default: 0)" << std::endl;
+        std::cerr << "         --id:      sender stamp used by the microservice (default: 8)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --service=./template-opencv --freq=30 --frames=3000 --load=2" << std::endl;
+    }
+    else {
+        const std::string SERVICE{commandlineArguments["service"]};
+        const std::string CID{(commandlineArguments.count("cid") != 0) ? commandlineArguments["cid"] : "111"};
+        const std::string NAME{(commandlineArguments.count("name") != 0) ? commandlineArguments["name"] : "latency"};
+        const uint32_t WIDTH{(commandlineArguments.count("width") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["width"])) : 640};
+        const uint32_t HEIGHT{(commandlineArguments.count("height") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["height"])) : 480};
+        const float FREQ{(commandlineArguments.count("freq") != 0) ? std::stof(commandlineArguments["freq"]) : 20.0f};
+        const uint32_t FRAMES{(commandlineArguments.count("frames") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["frames"])) : 1000};
+        const uint32_t WARMUP{(commandlineArguments.count("warmup") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["warmup"])) : 50};
+        const uint32_t LOAD{(commandlineArguments.count("load") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["load"])) : 0};
+        const uint32_t ID{(commandlineArguments.count("id") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["id"])) : 8};
+        const bool VERBOSE{commandlineArguments.count("verbose") != 0};
+
+        // Create the shared memory area that the microservice attaches to; it expects ARGB pixels.
+        std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME, WIDTH * HEIGHT * 4}};
+        if (!sharedMemory || !sharedMemory->valid()) {
+            std::cerr << argv[0] << ": Failed to create shared memory '" << NAME << "'." << std::endl;
+            return retCode;
+        }
+        std::clog << argv[0] << ": Created shared memory '" << sharedMemory->name() << "' (" << sharedMemory->size() << " bytes)." << std::endl;
+
+        // Rendered before the service starts, so that rendering does not compete with it; the track
+        // repeats after TRACK_FRAMES frames.
+        constexpr uint32_t TRACK_FRAMES{200};
+        const std::vector<SyntheticFrame> track{renderTrack(WIDTH, HEIGHT, std::min(WARMUP + FRAMES, TRACK_FRAMES))};
+
+        // Latencies in microseconds; reserved up front so that recording them does not allocate.
+        std::vector<int64_t> processingLatencies;
+        std::vector<int64_t> endToEndLatencies;
+        processingLatencies.reserve(FRAMES);
+        endToEndLatencies.reserve(FRAMES);
+        std::mutex latenciesMutex;
+        std::atomic<int64_t> firstMeasuredCapture{std::numeric_limits<int64_t>::max()};
+
+        cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(CID))};
+        od4.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), [&](cluon::data::Envelope &&env){
+            if (env.senderStamp() != ID) {
+                return;
+            }
+            const int64_t capture{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+            if (capture < firstMeasuredCapture.load()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lck(latenciesMutex);
+            if (processingLatencies.size() < FRAMES) {
+                // sent is stamped by the microservice when the request leaves it, received by us on arrival.
+                processingLatencies.push_back(cluon::time::deltaInMicroseconds(env.sent(), env.sampleTimeStamp()));
+                endToEndLatencies.push_back(cluon::time::deltaInMicroseconds(env.received(), env.sampleTimeStamp()));
+            }
+        });
+
+        const std::vector<std::string> arguments{"--cid=" + CID, "--name=" + NAME,
+            "--width=" + std::to_string(WIDTH), "--height=" + std::to_string(HEIGHT), "--id=" + std::to_string(ID)};
+        pid_t service = startMicroservice(SERVICE, arguments, VERBOSE);
+        if (service < 0) {
+            std::cerr << argv[0] << ": Failed to start '" << SERVICE << "'." << std::endl;
+            return retCode;
+        }
+
+        // Busy threads competing with the microservice for the CPU.
+        std::atomic<bool> loaded{true};
+        std::vector<std::thread> load;
+        for (uint32_t i{0}; i < LOAD; i++) {
+            load.emplace_back([&loaded](){
+                volatile double sink{1.0};
+                while (loaded.load(std::memory_order_relaxed)) {
+                    sink = std::sqrt(sink + 1.0);
+                }
+            });
+        }
+
+        // Give the microservice time to attach before the first frame.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        const auto PERIOD{std::chrono::microseconds(static_cast<int64_t>(1000.0f * 1000.0f / FREQ))};
+        auto nextFrame = std::chrono::steady_clock::now();
+        for (uint32_t frame{0}; (frame < WARMUP + FRAMES) && od4.isRunning(); frame++) {
+            std::this_thread::sleep_until(nextFrame);
+            nextFrame += PERIOD;
+
+            const cluon::data::TimeStamp now{cluon::time::now()};
+            if (frame == WARMUP) {
+                firstMeasuredCapture.store(cluon::time::toMicroseconds(now));
+            }
+            sharedMemory->lock();
+            const cv::Mat &image = track[frame % track.size()].image;
+            std::memcpy(sharedMemory->data(), image.data, image.total() * image.elemSize());
+            sharedMemory->setTimeStamp(now);
+            sharedMemory->unlock();
+            sharedMemory->notifyAll();
+        }
+
+        // Let the last requests arrive.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        loaded.store(false);
+        for (auto &t : load) {
+            t.join();
+        }
+        stopMicroservice(service, *sharedMemory);
+
+        std::lock_guard<std::mutex> lck(latenciesMutex);
+        std::cout << "Frames: " << FRAMES << " at " << FREQ << " Hz with " << LOAD << " busy threads; answered: " << processingLatencies.size()
+                  << " (" << std::fixed << std::setprecision(1) << (100.0 * static_cast<double>(processingLatencies.size()) / FRAMES) << "%)" << std::endl;
+        printDistribution("capture-to-output (sent - sampleTimeStamp)", processingLatencies);
+        printDistribution("capture-to-actuation (received - sampleTimeStamp)", endToEndLatencies);
+        retCode = processingLatencies.empty() ? 1 : 0;
+    }
+    return retCode;
+}
+
+// Starts the microservice as child process with the given command line arguments
+pid_t startMicroservice(const std::string &service, const std::vector<std::string> &arguments, bool verbose) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(service.c_str()));
+    for (const auto &a : arguments) {
+        argv.push_back(const_cast<char*>(a.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // The per-frame output of the microservice is not of interest here. /dev/null is opened before
+    // forking: the child of a process with threads may only make async-signal-safe calls like dup2.
+    const int devNull{verbose ? -1 : ::open("/dev/null", O_WRONLY | O_CLOEXEC)};
+    if (!verbose && (0 > devNull)) {
+        return -1;
+    }
+    pid_t pid = fork();
+    if (0 == pid) {
+        if (!verbose && (0 > ::dup2(devNull, STDOUT_FILENO))) {
+            _exit(1);
+        }
+        execv(service.c_str(), argv.data());
+        _exit(1);
+    }
+    if (!verbose) {
+        ::close(devNull);
+    }
+    return pid;
+}
+
+// Asks the microservice to terminate; the notifications wake it up if it is waiting for a frame
+void stopMicroservice(pid_t pid, cluon::SharedMemory &sharedMemory) {
+    kill(pid, SIGTERM);
+    int status{0};
+    for (uint32_t attempt{0}; attempt < 20; attempt++) {
+        sharedMemory.notifyAll();
+        if (waitpid(pid, &status, WNOHANG) == pid) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, &status, 0);
+}
+
+// Renders the frames of a synthetic track as the camera would deliver them (BGRA)
+std::vector<SyntheticFrame> renderTrack(uint32_t width, uint32_t height, uint32_t frames) {
+    SyntheticTrack track{width, height, 1};
+    std::vector<SyntheticFrame> rendered(frames);
+    for (uint32_t i{0}; i < frames; i++) {
+        track.render(i, rendered[i]);
+    }
+    return rendered;
+}
+
+// Prints the latency distribution in microseconds
+void printDistribution(const std::string &label, std::vector<int64_t> &latencies) {
+    if (latencies.empty()) {
+        std::cout << label << ": no samples" << std::endl;
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        const size_t index{static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(latencies.size()))) - 1};
+        return latencies[std::min(index, latencies.size() - 1)];
+    };
+    double sum{0.0};
+    for (auto l : latencies) {
+        sum += static_cast<double>(l);
+    }
+    std::cout << label << " [us]: min " << latencies.front()
+              << "; p50 " << percentile(50.0)
+              << "; p90 " << percentile(90.0)
+              << "; p99 " << percentile(99.0)
+              << "; p99.9 " << percentile(99.9)
+              << "; max " << latencies.back()
+              << "; mean " << std::fixed << std::setprecision(1) << (sum / static_cast<double>(latencies.size())) << std::endl;
+}
@@ -0,0 +1,137 @@
+// Include the single-file, header-only middleware libcluon for its parser of message specifications
+#include "cluon-complete.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//------------------ Function declaration -------------------
+bool isFixedLayout(const cluon::MetaMessage &message);
+void generate(std::ostream &out, const std::string &specification, const std::vector<cluon::MetaMessage> &messages);
+//------------------ Function declaration -------------------
+
+// The generator runs at build time like cluon-msc: it writes plain structs for the messages of one package
+// that only have fixed-size fields (numbers, bools and chars), together with a decoder for each that reads
+// the payload of an envelope in place via pod::ProtoReader.
+int32_t main(int32_t argc, char **argv) {
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ((0 == commandlineArguments.count("in")) || (0 == commandlineArguments.count("out"))) {
+        std::cerr << argv[0] << " generates allocation-free decoders for the fixed-layout messages of a message specification." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --in=<.odvd file> --out=<.hpp file> [--package=<package>]" << std::endl;
+        std::cerr << "         --package: only messages of this package (default: opendlv.proxy)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --in=opendlv-standard-message-set-v0.9.6.odvd --out=opendlv-standard-message-set-pod.hpp" << std::endl;
+        return retCode;
+    }
+    const std::string IN{commandlineArguments["in"]};
+    const std::string OUT{commandlineArguments["out"]};
+    const std::string PACKAGE{(commandlineArguments.count("package") != 0) ? commandlineArguments["package"] : "opendlv.proxy"};
+
+    std::ifstream in(IN);
+    std::stringstream specification;
+    specification << in.rdbuf();
+    if (!in.good()) {
+        std::cerr << argv[0] << ": Failed to read '" << IN << "'." << std::endl;
+        return retCode;
+    }
+
+    cluon::MessageParser parser;
+    auto result = parser.parse(specification.str());
+    if (cluon::MessageParser::NO_MESSAGEPARSER_ERROR != result.second) {
+        std::cerr << argv[0] << ": Failed to parse '" << IN << "'." << std::endl;
+        return retCode;
+    }
+
+    std::vector<cluon::MetaMessage> messages;
+    for (const auto &message : result.first) {
+        const std::string name{message.packageName() + (message.packageName().empty() ? "" : ".") + message.messageName()};
+        if ((0 == name.find(PACKAGE + ".")) && (std::string::npos == name.find('.', PACKAGE.size() + 1)) && isFixedLayout(message)) {
+            messages.push_back(message);
+        }
+    }
+
+    const std::string specificationName{IN.substr(IN.find_last_of('/') + 1)};
+    std::ofstream out(OUT, std::ios::out | std::ios::trunc);
+    generate(out, specificationName, messages);
+    if (out.good()) {
+        std::clog << argv[0] << ": Generated decoders for " << messages.size() << " messages of " << PACKAGE << "." << std::endl;
+        retCode = 0;
+    } else {
+        std::cerr << argv[0] << ": Failed to write '" << OUT << "'." << std::endl;
+    }
+    return retCode;
+}
+
+bool isFixedLayout(const cluon::MetaMessage &message) {
+    for (const auto &field : message.listOfMetaFields()) {
+        const auto type = field.fieldDataType();
+        if ((cluon::MetaMessage::MetaField::STRING_T == type) || (cluon::MetaMessage::MetaField::BYTES_T == type)
+            || (cluon::MetaMessage::MetaField::MESSAGE_T == type) || (cluon::MetaMessage::MetaField::UNDEFINED_T == type)) {
+            return false;
+        }
+    }
+    return !message.listOfMetaFields().empty();
+}
+
+void generate(std::ostream &out, const std::string &specification, const std::vector<cluon::MetaMessage> &messages) {
+    const std::map<cluon::MetaMessage::MetaField::MetaFieldDataTypes, std::pair<std::string, std::string>> TYPES{
+        {cluon::MetaMessage::MetaField::BOOL_T, {"bool", "false"}},
+        {cluon::MetaMessage::MetaField::CHAR_T, {"char", "'\\0'"}},
+        {cluon::MetaMessage::MetaField::UINT8_T, {"uint8_t", "0"}},
+        {cluon::MetaMessage::MetaField::INT8_T, {"int8_t", "0"}},
+        {cluon::MetaMessage::MetaField::UINT16_T, {"uint16_t", "0"}},
+        {cluon::MetaMessage::MetaField::INT16_T, {"int16_t", "0"}},
+        {cluon::MetaMessage::MetaField::UINT32_T, {"uint32_t", "0"}},
+        {cluon::MetaMessage::MetaField::INT32_T, {"int32_t", "0"}},
+        {cluon::MetaMessage::MetaField::UINT64_T, {"uint64_t", "0"}},
+        {cluon::MetaMessage::MetaField::INT64_T, {"int64_t", "0"}},
+        {cluon::MetaMessage::MetaField::FLOAT_T, {"float", "0.0"}},
+        {cluon::MetaMessage::MetaField::DOUBLE_T, {"double", "0.0"}},
+    };
+
+    out << "// Generated by od4-pod-generator from " << specification << "; do not edit.\n"
+        << "#ifndef OD4_POD_MESSAGES_HPP\n"
+        << "#define OD4_POD_MESSAGES_HPP\n\n"
+        << "#include \"ProtoReader.hpp\"\n\n"
+        << "#include <cstdint>\n\n";
+
+    for (const auto &message : messages) {
+        // opendlv.proxy.GroundSteeringRequest becomes opendlv::proxy::pod::GroundSteeringRequest
+        const std::string fullName{message.packageName() + (message.packageName().empty() ? "" : ".") + message.messageName()};
+        const std::string name{fullName.substr(fullName.find_last_of('.') + 1)};
+        std::string namespaces{fullName.substr(0, fullName.find_last_of('.'))};
+        uint32_t depth{1};
+        for (size_t dot{namespaces.find('.')}; std::string::npos != dot; dot = namespaces.find('.', dot)) {
+            namespaces.replace(dot, 1, " { namespace ");
+            depth++;
+        }
+
+        out << "namespace " << namespaces << " { namespace pod {\n"
+            << "struct " << name << " {\n"
+            << "    static constexpr int32_t ID() noexcept { return " << message.messageIdentifier() << "; }\n";
+        for (const auto &field : message.listOfMetaFields()) {
+            const auto &type = TYPES.at(field.fieldDataType());
+            const std::string value{field.defaultInitializationValue().empty() ? type.second : field.defaultInitializationValue()};
+            const std::string suffix{(cluon::MetaMessage::MetaField::FLOAT_T == field.fieldDataType()) ? "f" : ""};
+            out << "    " << type.first << " " << field.fieldName() << "{" << value << suffix << "};\n";
+        }
+        out << "};\n\n"
+            << "inline bool decode(const char *data, size_t size, " << name << " &message) noexcept {\n"
+            << "    ::pod::ProtoReader reader{data, size};\n"
+            << "    while (reader.next()) {\n"
+            << "        switch (reader.fieldIdentifier()) {\n";
+        for (const auto &field : message.listOfMetaFields()) {
+            out << "            case " << field.fieldIdentifier() << ": reader.read(message." << field.fieldName() << "); break;\n";
+        }
+        out << "            default: break;\n"
+            << "        }\n"
+            << "    }\n"
+            << "    return reader.ok();\n"
+            << "}\n"
+            << std::string(depth + 1, '}') << "\n\n";
+    }
+    out << "#endif\n";
+}
@@ -0,0 +1,184 @@
+// Include the single-file, header-only middleware libcluon to create high-performance microservices
+#include "cluon-complete.hpp"
+// Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
+#include "opendlv-standard-message-set.hpp"
+// The same stages as in the microservice
+#include "ConeDetector.hpp"
+#include "SteeringCalculator.hpp"
+#include "SteeringFilter.hpp"
+#include "SteeringAccuracy.hpp"
+// Renders the frames together with the expected results
+#include "SyntheticTrack.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/videoio/videoio.hpp>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Runs the cone detection and steering calculation of one frame and counts the raw and filtered angle
+class Evaluation {
+   public:
+    explicit Evaluation(bool reducedResolution) noexcept : m_reducedResolution(reducedResolution) {}
+
+    void process(const cv::Mat &frame, int64_t captureTime, float groundSteering) {
+        // Same region of interest as in the microservice
+        const cv::Mat roi{frame(cv::Rect(0, 265, 640, 140))};
+        m_detector.detect(roi, m_reducedResolution, m_blueCones, m_yellowCones);
+        uint32_t coneCase{0};
+        const float calculatedAngle{m_steering.calculateAngle(m_blueCones, m_yellowCones, coneCase)};
+        const float filteredAngle{m_filter.update(calculatedAngle, coneCase, static_cast<float>(captureTime - m_previousCapture) / 1000000.0f)};
+        m_previousCapture = captureTime;
+        m_accuracy.count(coneCase, groundSteering, calculatedAngle);
+        m_filteredAccuracy.count(coneCase, groundSteering, filteredAngle);
+    }
+
+    uint64_t frames() const noexcept { return m_accuracy.frames(); }
+
+    void print(std::ostream &out) const {
+        out << "case;frames;accuracy;filtered accuracy" << std::endl;
+        for (uint32_t i{1}; i <= 6; i++) {
+            out << i << ";" << m_accuracy.frames(i) << ";" << m_accuracy.accuracy(i) << ";" << m_filteredAccuracy.accuracy(i) << std::endl;
+        }
+        out << "all;" << m_accuracy.frames() << ";" << m_accuracy.averageAccuracy() << ";" << m_filteredAccuracy.averageAccuracy() << std::endl;
+    }
+
+   private:
+    const bool m_reducedResolution;
+    ConeDetector m_detector{};
+    SteeringCalculator m_steering{};
+    SteeringFilter m_filter{};
+    std::array<cv::Point2f,2> m_blueCones{};
+    std::array<cv::Point2f,2> m_yellowCones{};
+    int64_t m_previousCapture{0};
+    SteeringAccuracy m_accuracy{};
+    SteeringAccuracy m_filteredAccuracy{};
+};
+
+int32_t main(int32_t argc, char **argv) {
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (commandlineArguments.count("help") != 0) {
+        std::cerr << argv[0] << " runs the cone detection and steering calculation offline and prints the accuracy for each case, with and without the filter." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " [--rec=<file>] [--frames=<n>] [--freq=<Hz>] [--seed=<n>] [--noise=<sigma>] [--lighting=<0..1>] [--dropout=<0..1>] [--yellow-left] [--reduced]" << std::endl;
+        std::cerr << "         --rec:      replay the raw BGRA or h264 ImageReadings of a 640x480 recording against its GroundSteeringRequests;" << std::endl;
+        std::cerr << "                     without it, synthetic frames are rendered (see template-opencv-synthetic for the other options)" << std::endl;
+        std::cerr << "         --reduced:  evaluate the degraded fast path at half resolution" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --frames=4000 --dropout=0.3" << std::endl;
+        return retCode;
+    }
+
+    Evaluation evaluation{commandlineArguments.count("reduced") != 0};
+    if (commandlineArguments.count("rec") != 0) {
+        std::ifstream rec(commandlineArguments["rec"], std::ios::in | std::ios::binary);
+        if (!rec.good()) {
+            std::cerr << argv[0] << ": Failed to open '" << commandlineArguments["rec"] << "'." << std::endl;
+            return retCode;
+        }
+        float groundSteering{0.0f};
+        uint64_t skipped{0};
+        // h264 frames depend on each other; they are collected into one stream that is decoded at the end
+        struct EncodedFrame {
+            int64_t captureTime;
+            float groundSteering;
+        };
+        std::vector<EncodedFrame> encodedFrames;
+        const std::string h264Path{"/tmp/template-opencv-evaluate-" + std::to_string(::getpid()) + ".h264"};
+        std::ofstream h264;
+        while (rec.good()) {
+            auto entry = cluon::extractEnvelope(rec);
+            if (!entry.first) {
+                continue;
+            }
+            cluon::data::Envelope &envelope = entry.second;
+            if ((opendlv::proxy::GroundSteeringRequest::ID() == envelope.dataType()) && (0 == envelope.senderStamp())) {
+                groundSteering = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(envelope)).groundSteering();
+            }
+            else if (opendlv::proxy::ImageReading::ID() == envelope.dataType()) {
+                const int64_t captureTime{cluon::time::toMicroseconds(envelope.sampleTimeStamp())};
+                opendlv::proxy::ImageReading reading{cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(envelope))};
+                if (("h264" == reading.fourcc()) && (640 == reading.width()) && (480 == reading.height())) {
+                    if (!h264.is_open()) {
+                        h264.open(h264Path, std::ios::out | std::ios::binary | std::ios::trunc);
+                    }
+                    h264.write(reading.data().data(), static_cast<std::streamsize>(reading.data().size()));
+                    encodedFrames.push_back(EncodedFrame{captureTime, groundSteering});
+                    continue;
+                }
+                if (("BGRA" != reading.fourcc()) || (640 != reading.width()) || (480 != reading.height()) ||
+                    (reading.data().size() != 640u * 480u * 4u)) {
+                    skipped++;
+                    continue;
+                }
+                const cv::Mat frame(480, 640, CV_8UC4, const_cast<char*>(reading.data().data()));
+                evaluation.process(frame, captureTime, groundSteering);
+            }
+        }
+        if (!encodedFrames.empty()) {
+            h264.close();
+            // A decoder that joins the stream late leaves out the first frames; the decoded frames are
+            // therefore matched with the recorded ones from the end
+            uint64_t decodable{0};
+            cv::VideoCapture counter{h264Path};
+            while (counter.isOpened() && counter.grab()) {
+                decodable++;
+            }
+            decodable = std::min<uint64_t>(decodable, encodedFrames.size());
+            cv::VideoCapture decoder{h264Path};
+            cv::Mat bgr;
+            cv::Mat bgra;
+            for (uint64_t i{encodedFrames.size() - decodable}; (i < encodedFrames.size()) && decoder.read(bgr); i++) {
+                if ((640 != bgr.cols) || (480 != bgr.rows)) {
+                    continue;
+                }
+                cv::cvtColor(bgr, bgra, cv::COLOR_BGR2BGRA);
+                evaluation.process(bgra, encodedFrames[i].captureTime, encodedFrames[i].groundSteering);
+            }
+            if (0 == decodable) {
+                std::cerr << argv[0] << ": Failed to decode the h264 frames; OpenCV may lack a video backend like FFmpeg." << std::endl;
+            }
+            skipped += encodedFrames.size() - decodable;
+            std::remove(h264Path.c_str());
+        }
+        if (skipped > 0) {
+            std::cerr << argv[0] << ": Skipped " << skipped << " frames that are neither raw 640x480 BGRA nor decodable h264." << std::endl;
+        }
+        if (0 == evaluation.frames()) {
+            std::cerr << argv[0] << ": No frame of '" << commandlineArguments["rec"] << "' could be evaluated." << std::endl;
+            return retCode;
+        }
+    }
+    else {
+        const uint32_t FRAMES{(commandlineArguments.count("frames") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["frames"])) : 4000};
+        const float FREQ{(commandlineArguments.count("freq") != 0) ? std::stof(commandlineArguments["freq"]) : 20.0f};
+        const uint32_t SEED{(commandlineArguments.count("seed") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["seed"])) : 1};
+
+        SyntheticTrack track{640, 480, SEED};
+        track.yellowOnLeft(commandlineArguments.count("yellow-left") != 0);
+        if (commandlineArguments.count("noise") != 0) {
+            track.noise(std::stod(commandlineArguments["noise"]));
+        }
+        if (commandlineArguments.count("lighting") != 0) {
+            track.lightingVariation(std::stod(commandlineArguments["lighting"]));
+        }
+        if (commandlineArguments.count("dropout") != 0) {
+            track.dropoutProbability(std::stod(commandlineArguments["dropout"]));
+        }
+
+        SyntheticFrame frame;
+        const int64_t PERIOD{static_cast<int64_t>(1000.0f * 1000.0f / FREQ)};
+        for (uint32_t i{0}; i < FRAMES; i++) {
+            track.render(i, frame);
+            evaluation.process(frame.image, PERIOD * (i + 1), frame.groundSteering);
+        }
+    }
+    evaluation.print(std::cout);
+    retCode = 0;
+    return retCode;
+}
@@ -0,0 +1,145 @@
+// Include the single-file, header-only middleware libcluon to create high-performance microservices
+#include "cluon-complete.hpp"
+// Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
+#include "opendlv-standard-message-set.hpp"
+// Renders the frames together with the expected results
+#include "SyntheticTrack.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+//------------------ Function declaration -------------------
+template <typename T>
+void writeEnvelope(std::ofstream &rec, T &message, const cluon::data::TimeStamp &sampleTime);
+//------------------ Function declaration -------------------
+
+int32_t main(int32_t argc, char **argv) {
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    const std::string OUT{(commandlineArguments.count("out") != 0) ? commandlineArguments["out"] : ""};
+    if ( ((OUT != "mem") && (OUT != "shm") && (OUT != "rec")) ||
+         (("shm" == OUT) && (0 == commandlineArguments.count("name"))) ||
+         (("rec" == OUT) && (0 == commandlineArguments.count("rec"))) ) {
+        std::cerr << argv[0] << " renders synthetic track frames with blue and yellow cones and the expected steering angle." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --out=<mem|shm|rec> [--name=<shared memory area>] [--cid=<OD4 session>] [--rec=<file>] [--width=<w>] [--height=<h>] [--frames=<n>] [--freq=<Hz>] [--seed=<n>] [--noise=<sigma>] [--lighting=<0..1>] [--dropout=<0..1>] [--yellow-left] [--expected]" << std::endl;
+        std::cerr << "         --out:         mem renders as fast as possible and reports the throughput," << std::endl;
+        std::cerr << "                        shm writes into the shared memory area --name at --freq," << std::endl;
+        std::cerr << "                        rec writes ImageReading (raw BGRA) and GroundSteeringRequest envelopes into --rec" << std::endl;
+        std::cerr << "         --cid:         with shm, also send the ground truth as GroundSteeringRequest to this OD4 session" << std::endl;
+        std::cerr << "         --width:       width of the frame (default: 640)" << std::endl;
+        std::cerr << "         --height:      height of the frame (default: 480)" << std::endl;
+        std::cerr << "         --frames:      number of frames (default: 1000)" << std::endl;
+        std::cerr << "         --freq:        frame rate for shm and the time stamps in rec (default: 20)" << std::endl;
+        std::cerr << "         --seed:        seed for the cone dropouts and noise (default: 1)" << std::endl;
+        std::cerr << "         --noise:       standard deviation of the pixel noise (default: 4)" << std::endl;
+        std::cerr << "         --lighting:    amount of lighting variation (default: 0.2)" << std::endl;
+        std::cerr << "         --dropout:     probability that a cone is missing in a frame (default: 0.15)" << std::endl;
+        std::cerr << "         --yellow-left: yellow cones on the left (default: on the right)" << std::endl;
+        std::cerr << "         --expected:    print frame;sampleTimeStamp;groundSteering;expectedAngle;case for every frame" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --out=shm --name=img --cid=253 --freq=30 --expected" << std::endl;
+    }
+    else {
+        const uint32_t WIDTH{(commandlineArguments.count("width") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["width"])) : 640};
+        const uint32_t HEIGHT{(commandlineArguments.count("height") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["height"])) : 480};
+        const uint32_t FRAMES{(commandlineArguments.count("frames") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["frames"])) : 1000};
+        const float FREQ{(commandlineArguments.count("freq") != 0) ? std::stof(commandlineArguments["freq"]) : 20.0f};
+        const uint32_t SEED{(commandlineArguments.count("seed") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["seed"])) : 1};
+        const bool EXPECTED{commandlineArguments.count("expected") != 0};
+
+        SyntheticTrack track{WIDTH, HEIGHT, SEED};
+        track.yellowOnLeft(commandlineArguments.count("yellow-left") != 0);
+        if (commandlineArguments.count("noise") != 0) {
+            track.noise(std::stod(commandlineArguments["noise"]));
+        }
+        if (commandlineArguments.count("lighting") != 0) {
+            track.lightingVariation(std::stod(commandlineArguments["lighting"]));
+        }
+        if (commandlineArguments.count("dropout") != 0) {
+            track.dropoutProbability(std::stod(commandlineArguments["dropout"]));
+        }
+
+        std::unique_ptr<cluon::SharedMemory> sharedMemory;
+        std::unique_ptr<cluon::OD4Session> od4;
+        std::ofstream rec;
+        if ("shm" == OUT) {
+            sharedMemory.reset(new cluon::SharedMemory{commandlineArguments["name"], WIDTH * HEIGHT * 4});
+            if (!sharedMemory->valid()) {
+                std::cerr << argv[0] << ": Failed to create shared memory '" << commandlineArguments["name"] << "'." << std::endl;
+                return retCode;
+            }
+            std::clog << argv[0] << ": Created shared memory '" << sharedMemory->name() << "' (" << sharedMemory->size() << " bytes)." << std::endl;
+            if (commandlineArguments.count("cid") != 0) {
+                od4.reset(new cluon::OD4Session{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))});
+            }
+        }
+        else if ("rec" == OUT) {
+            rec.open(commandlineArguments["rec"], std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!rec.good()) {
+                std::cerr << argv[0] << ": Failed to open '" << commandlineArguments["rec"] << "'." << std::endl;
+                return retCode;
+            }
+        }
+
+        SyntheticFrame frame;
+        const int64_t PERIOD{static_cast<int64_t>(1000.0f * 1000.0f / FREQ)};
+        const int64_t START{cluon::time::toMicroseconds(cluon::time::now())};
+        auto nextFrame = std::chrono::steady_clock::now();
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint32_t i{0}; i < FRAMES; i++) {
+            track.render(i, frame);
+
+            // Time stamps of rec files are spaced by the frame rate; shm uses the actual capture time
+            cluon::data::TimeStamp sampleTime{cluon::time::fromMicroseconds(START + PERIOD * i)};
+            if ("shm" == OUT) {
+                std::this_thread::sleep_until(nextFrame);
+                nextFrame += std::chrono::microseconds(PERIOD);
+                sampleTime = cluon::time::now();
+                sharedMemory->lock();
+                std::memcpy(sharedMemory->data(), frame.image.data, frame.image.total() * frame.image.elemSize());
+                sharedMemory->setTimeStamp(sampleTime);
+                sharedMemory->unlock();
+                sharedMemory->notifyAll();
+                if (od4) {
+                    opendlv::proxy::GroundSteeringRequest gsr;
+                    gsr.groundSteering(frame.groundSteering);
+                    od4->send(gsr, sampleTime);
+                }
+            }
+            else if ("rec" == OUT) {
+                opendlv::proxy::ImageReading reading;
+                reading.fourcc("BGRA").width(WIDTH).height(HEIGHT)
+                       .data(std::string(reinterpret_cast<const char*>(frame.image.data), frame.image.total() * frame.image.elemSize()));
+                writeEnvelope(rec, reading, sampleTime);
+                opendlv::proxy::GroundSteeringRequest gsr;
+                gsr.groundSteering(frame.groundSteering);
+                writeEnvelope(rec, gsr, sampleTime);
+            }
+
+            if (EXPECTED) {
+                std::cout << i << ";" << cluon::time::toMicroseconds(sampleTime) << ";" << frame.groundSteering << ";" << frame.expectedAngle << ";" << frame.coneCase << std::endl;
+            }
+        }
+        const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+        std::clog << argv[0] << ": " << FRAMES << " frames of " << WIDTH << "x" << HEIGHT << " in " << seconds << " s ("
+                  << (static_cast<double>(FRAMES) / seconds) << " frames/s)." << std::endl;
+        retCode = 0;
+    }
+    return retCode;
+}
+
+// Appends the message in an envelope, in the same format as recorded by the OpenDLV tools
+template <typename T>
+void writeEnvelope(std::ofstream &rec, T &message, const cluon::data::TimeStamp &sampleTime) {
+    cluon::ToProtoVisitor protoEncoder;
+    message.accept(protoEncoder);
+    cluon::data::Envelope envelope;
+    envelope.dataType(static_cast<int32_t>(message.ID()))
+            .serializedData(protoEncoder.encodedData())
+            .sent(sampleTime)
+            .sampleTimeStamp(sampleTime);
+    const std::string data{cluon::serializeEnvelope(std::move(envelope))};
+    rec.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
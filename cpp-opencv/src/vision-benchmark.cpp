@@ -0,0 +1,190 @@
+// Include the single-file, header-only middleware libcluon to create high-performance microservices
+#include "cluon-complete.hpp"
+// The stages of the frame loop that are measured
+#include "ConeDetector.hpp"
+#include "SteeringCalculator.hpp"
+#include "ThresholdKernels.hpp"
+// Hardware counters of the measured stages
+#include "PerfCounters.hpp"
+// Renders the frames together with the expected results
+#include "SyntheticTrack.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+//------------------ Function declaration -------------------
+void printTimes(const std::string &name, std::vector<double> &times, const PerfCounters::Reading *counters);
+//------------------ Function declaration -------------------
+
+int32_t main(int32_t argc, char **argv) {
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (commandlineArguments.count("help") != 0) {
+        std::cerr << argv[0] << " measures the vision kernels and the cone detection on synthetic 640x480 frames." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " [--frames=<n>] [--seed=<n>] [--counters]" << std::endl;
+        std::cerr << "         --frames:   number of frames to measure (default: 1000)" << std::endl;
+        std::cerr << "         --seed:     seed of the synthetic frames (default: 1)" << std::endl;
+        std::cerr << "         --counters: also report IPC, cache and branch misses per frame from the hardware counters" << std::endl;
+        return retCode;
+    }
+    const uint32_t FRAMES{(commandlineArguments.count("frames") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["frames"])) : 1000};
+    const uint32_t SEED{(commandlineArguments.count("seed") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["seed"])) : 1};
+
+    // Without access to the counters (containers, kernel.perf_event_paranoid), only the times are reported
+    std::unique_ptr<PerfCounters> perfCounters;
+    if (commandlineArguments.count("counters") != 0) {
+        perfCounters.reset(new PerfCounters);
+        if (!perfCounters->reasons().empty()) {
+            std::cerr << argv[0] << ": Some hardware counters are not available (" << perfCounters->reasons() << ")." << std::endl;
+        }
+        if (!perfCounters->available()) {
+            perfCounters.reset();
+        }
+    }
+    PerfCounters::Reading reading;
+    const PerfCounters::Reading *counters{perfCounters ? &reading : nullptr};
+
+    // Render a few different frames up front, so that rendering is not measured
+    const uint32_t DISTINCT_FRAMES{16};
+    SyntheticTrack track{640, 480, SEED};
+    std::vector<cv::Mat> rois;
+    std::vector<cv::Mat> hsvs;
+    for (uint32_t i{0}; i < DISTINCT_FRAMES; i++) {
+        SyntheticFrame frame;
+        track.render(i * 25, frame);
+        rois.push_back(frame.image(cv::Rect(0, 265, 640, 140)).clone());
+        cv::Mat hsv;
+        cv::cvtColor(rois.back(), hsv, cv::COLOR_BGR2HSV);
+        hsvs.push_back(hsv);
+    }
+
+    const HsvRange BLUE{{100, 100, 40}, {133, 255, 255}};
+    const HsvRange YELLOW{{15, 50, 130}, {25, 185, 255}};
+    std::cout << "selected kernel;" << selectedThresholdKernel().name << std::endl;
+    std::cout << "stage;kernel;mean us;p50 us;p99 us;max us" << (counters ? ";IPC;cache misses/frame;branch misses/frame" : "") << std::endl;
+
+    // Every variant has to give the same masks as the portable one
+    const size_t PIXELS{hsvs[0].total()};
+    std::vector<uint8_t> expectedBlue(PIXELS), expectedYellow(PIXELS), blue(PIXELS), yellow(PIXELS);
+    std::vector<double> times;
+    times.reserve(FRAMES);
+    bool identical{true};
+    for (const auto &kernel : availableThresholdKernels()) {
+        for (uint32_t i{0}; i < DISTINCT_FRAMES; i++) {
+            const cv::Mat &hsv{hsvs[i]};
+            kernel.function(hsv.ptr(), PIXELS, BLUE, YELLOW, blue.data(), yellow.data());
+            kernels::dualThresholdScalar(hsv.ptr(), PIXELS, BLUE, YELLOW, expectedBlue.data(), expectedYellow.data());
+            if ((blue != expectedBlue) || (yellow != expectedYellow)) {
+                std::cerr << argv[0] << ": The " << kernel.name << " kernel gives different masks than the scalar one." << std::endl;
+                identical = false;
+            }
+        }
+
+        times.clear();
+        if (perfCounters) {
+            perfCounters->start();
+        }
+        for (uint32_t i{0}; i < FRAMES; i++) {
+            const cv::Mat &hsv{hsvs[i % DISTINCT_FRAMES]};
+            const auto begin = std::chrono::steady_clock::now();
+            kernel.function(hsv.ptr(), PIXELS, BLUE, YELLOW, blue.data(), yellow.data());
+            times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+        }
+        if (perfCounters) {
+            reading = perfCounters->stop();
+        }
+        printTimes(std::string("threshold;") + kernel.name, times, counters);
+    }
+
+    // The contour search over the masks of both colours, which is the most branchy stage
+    {
+        std::vector<cv::Mat> masks;
+        for (uint32_t i{0}; i < DISTINCT_FRAMES; i++) {
+            kernels::dualThresholdScalar(hsvs[i].ptr(), PIXELS, BLUE, YELLOW, blue.data(), yellow.data());
+            masks.push_back(cv::Mat(hsvs[i].rows, hsvs[i].cols, CV_8UC1, blue.data()).clone());
+            masks.push_back(cv::Mat(hsvs[i].rows, hsvs[i].cols, CV_8UC1, yellow.data()).clone());
+        }
+        cv::Mat mask;
+        std::vector<std::vector<cv::Point>> contours;
+        std::vector<cv::Vec4i> hierarchy;
+        times.clear();
+        if (perfCounters) {
+            perfCounters->start();
+        }
+        for (uint32_t i{0}; i < FRAMES; i++) {
+            const auto begin = std::chrono::steady_clock::now();
+            for (uint32_t colour{0}; colour < 2; colour++) {
+                // findContours may modify its input
+                masks[(2 * i + colour) % masks.size()].copyTo(mask);
+                cv::findContours(mask, contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
+            }
+            times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+        }
+        if (perfCounters) {
+            reading = perfCounters->stop();
+        }
+        printTimes("contours;RETR_TREE", times, counters);
+    }
+
+    // The whole detection and angle calculation, as in the frame loop
+    for (const bool reducedResolution : {false, true}) {
+        ConeDetector detector;
+        SteeringCalculator steering;
+        std::array<cv::Point2f,2> blueCones;
+        std::array<cv::Point2f,2> yellowCones;
+        times.clear();
+        if (perfCounters) {
+            perfCounters->start();
+        }
+        for (uint32_t i{0}; i < FRAMES; i++) {
+            const auto begin = std::chrono::steady_clock::now();
+            detector.detect(rois[i % DISTINCT_FRAMES], reducedResolution, blueCones, yellowCones);
+            uint32_t coneCase{0};
+            steering.calculateAngle(blueCones, yellowCones, coneCase);
+            times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+        }
+        if (perfCounters) {
+            reading = perfCounters->stop();
+        }
+        printTimes(std::string(reducedResolution ? "detect reduced;" : "detect;") + detector.thresholdKernel(), times, counters);
+    }
+    retCode = identical ? 0 : 1;
+    return retCode;
+}
+
+void printTimes(const std::string &name, std::vector<double> &times, const PerfCounters::Reading *counters) {
+    if (times.empty()) {
+        return;
+    }
+    std::sort(times.begin(), times.end());
+    double sum{0.0};
+    for (const double t : times) {
+        sum += t;
+    }
+    std::cout << name << ";" << sum / static_cast<double>(times.size()) << ";" << times[times.size() / 2] << ";"
+              << times[(times.size() * 99) / 100] << ";" << times.back();
+    if (nullptr != counters) {
+        // Counters the CPU does not offer are left empty
+        const PerfCounters::Reading &c = *counters;
+        const double FRAMES{static_cast<double>(times.size())};
+        std::cout << ";";
+        if (c.has(PerfCounters::CYCLES) && c.has(PerfCounters::INSTRUCTIONS) && (c[PerfCounters::CYCLES] > 0)) {
+            std::cout << static_cast<double>(c[PerfCounters::INSTRUCTIONS]) / static_cast<double>(c[PerfCounters::CYCLES]);
+        }
+        std::cout << ";";
+        if (c.has(PerfCounters::CACHE_MISSES)) {
+            std::cout << static_cast<double>(c[PerfCounters::CACHE_MISSES]) / FRAMES;
+        }
+        std::cout << ";";
+        if (c.has(PerfCounters::BRANCH_MISSES)) {
+            std::cout << static_cast<double>(c[PerfCounters::BRANCH_MISSES]) / FRAMES;
+        }
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,163 @@
+#include "BatchChecker.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+constexpr size_t BatchChecker::BATCH;
+
+namespace {
+constexpr size_t OUTPUT_BUFFER{1 << 20};
+
+inline bool isDigit(char c) {
+    return (c >= '0') && (c <= '9');
+}
+}
+
+BatchChecker::BatchChecker(Format format, int outputFileDescriptor, const PrimeChecker &checker)
+    : m_format(format)
+    , m_output(outputFileDescriptor)
+    , m_checker(checker)
+    , m_buffer(OUTPUT_BUFFER) {
+}
+
+BatchChecker::~BatchChecker() {
+    flush();
+}
+
+size_t BatchChecker::feed(const char *data, size_t size, bool last) {
+    const size_t used{(Format::Text == m_format) ? feedText(data, size, last) : feedBinary(data, size, last)};
+    // The text of the numbers is only valid until we return
+    check();
+    return used;
+}
+
+size_t BatchChecker::feedText(const char *data, size_t size, bool last) {
+    const char *p{data};
+    const char *end{data + size};
+    while (true) {
+        while ((p < end) && !isDigit(*p) && ('-' != *p)) {
+            p++;
+        }
+        if (p == end) {
+            break;
+        }
+        const char *text{p};
+        const bool negative{'-' == *p};
+        p += negative ? 1 : 0;
+        uint64_t value{0};
+        bool overflow{false};
+        for (; (p < end) && isDigit(*p); p++) {
+            overflow |= __builtin_mul_overflow(value, static_cast<uint64_t>(10), &value);
+            overflow |= __builtin_add_overflow(value, static_cast<uint64_t>(*p - '0'), &value);
+        }
+        if ((p == end) && !last) {
+            // The number may go on in the next data
+            p = text;
+            break;
+        }
+        if ((p - text) == (negative ? 1 : 0)) {
+            // A lonely minus
+            continue;
+        }
+        m_invalid += overflow ? 1 : 0;
+        m_batch[m_count] = (negative || overflow) ? 0 : value;
+        m_text[m_count] = text;
+        m_length[m_count] = static_cast<uint32_t>(p - text);
+        if (BATCH == ++m_count) {
+            check();
+        }
+    }
+    return static_cast<size_t>(p - data);
+}
+
+size_t BatchChecker::feedBinary(const char *data, size_t size, bool last) {
+    const size_t complete{size - size % sizeof(uint64_t)};
+    for (size_t offset{0}; offset < complete; offset += sizeof(uint64_t)) {
+        uint64_t value;
+        std::memcpy(&value, data + offset, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        value = __builtin_bswap64(value);
+#endif
+        m_batch[m_count] = value;
+        if (BATCH == ++m_count) {
+            check();
+        }
+    }
+    if (last && (complete != size)) {
+        m_invalid++;
+        return size;
+    }
+    return complete;
+}
+
+void BatchChecker::check() {
+    if (0 == m_count) {
+        return;
+    }
+    m_checker.isPrime(m_batch, m_count, m_results);
+    for (size_t i{0}; i < m_count; i++) {
+        m_primes += m_results[i];
+    }
+    m_numbers += m_count;
+
+    if (Format::Binary == m_format) {
+        write(reinterpret_cast<const char *>(m_results), m_count);
+    }
+    else {
+        for (size_t i{0}; i < m_count; i++) {
+            // The number, ";0" or ";1" and the newline
+            if ((m_buffered + m_length[i] + 3) > m_buffer.size()) {
+                flush();
+            }
+            if ((m_length[i] + 3) > m_buffer.size()) {
+                write(m_text[i], m_length[i]);
+                write((0 != m_results[i]) ? ";1\n" : ";0\n", 3);
+                continue;
+            }
+            char *out{m_buffer.data() + m_buffered};
+            std::memcpy(out, m_text[i], m_length[i]);
+            out += m_length[i];
+            *out++ = ';';
+            *out++ = static_cast<char>('0' + m_results[i]);
+            *out++ = '\n';
+            m_buffered = static_cast<size_t>(out - m_buffer.data());
+        }
+    }
+    m_count = 0;
+}
+
+void BatchChecker::write(const char *data, size_t size) {
+    while (0 < size) {
+        if (m_buffered == m_buffer.size()) {
+            flush();
+        }
+        const size_t part{std::min(size, m_buffer.size() - m_buffered)};
+        std::memcpy(m_buffer.data() + m_buffered, data, part);
+        m_buffered += part;
+        data += part;
+        size -= part;
+    }
+}
+
+bool BatchChecker::flush() {
+    const char *data{m_buffer.data()};
+    size_t left{m_buffered};
+    while ((0 < left) && !m_failed) {
+        const ssize_t written{::write(m_output, data, left)};
+        if ((0 > written) && (EINTR == errno)) {
+            // A signal came before anything was written
+            continue;
+        }
+        if (0 >= written) {
+            // E.g. the reader of a pipe is gone; the results are dropped from now on
+            m_failed = true;
+            break;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+    m_buffered = 0;
+    return !m_failed;
+}
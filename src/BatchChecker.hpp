@@ -0,0 +1,63 @@
+#ifndef BATCHCHECKER
+#define BATCHCHECKER
+#include "PrimeChecker.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// Checks a stream of numbers in batches of the batch API and writes the results through a large buffer.
+// Text input is numbers separated by anything but digits; every number is written back as it was read,
+// followed by ";1" for a prime or ";0" otherwise (also for negative numbers and numbers beyond 64 bits).
+// Binary input is 64-bit little-endian numbers; one byte (0 or 1) is written per number.
+// Nothing is allocated per number: the numbers are parsed in place and echoed from the input.
+class BatchChecker {
+   private:
+    BatchChecker(const BatchChecker &) = delete;
+    BatchChecker(BatchChecker &&)      = delete;
+    BatchChecker &operator=(const BatchChecker &) = delete;
+    BatchChecker &operator=(BatchChecker &&) = delete;
+
+   public:
+    enum class Format { Text, Binary };
+
+    // The checker is copied, e.g. with its prime table
+    BatchChecker(Format format, int outputFileDescriptor, const PrimeChecker &checker = PrimeChecker{});
+    ~BatchChecker();
+
+    // Checks the numbers in data and returns the bytes used; a number that may continue in the next data is
+    // left over unless this is the last data
+    size_t feed(const char *data, size_t size, bool last);
+    // Writes the buffered results
+    bool flush();
+
+    uint64_t numberOfNumbers() const { return m_numbers; }
+    uint64_t numberOfPrimes() const { return m_primes; }
+    // Numbers beyond 64 bits, and the bytes of an incomplete number at the end of binary input
+    uint64_t numberOfInvalidNumbers() const { return m_invalid; }
+
+   private:
+    size_t feedText(const char *data, size_t size, bool last);
+    size_t feedBinary(const char *data, size_t size, bool last);
+    // Checks the collected numbers and writes their results
+    void check();
+    void write(const char *data, size_t size);
+
+   private:
+    static constexpr size_t BATCH{4096};
+
+    const Format m_format;
+    const int m_output;
+    PrimeChecker m_checker;
+    uint64_t m_batch[BATCH];
+    uint8_t m_results[BATCH];
+    // Where the numbers of the batch are in the text input
+    const char *m_text[BATCH];
+    uint32_t m_length[BATCH];
+    size_t m_count{0};
+    std::vector<char> m_buffer;
+    size_t m_buffered{0};
+    bool m_failed{false};
+    uint64_t m_numbers{0};
+    uint64_t m_primes{0};
+    uint64_t m_invalid{0};
+};
+#endif
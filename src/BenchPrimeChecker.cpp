@@ -0,0 +1,213 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this once per test-runner!
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "catch.hpp"
+#include "Factoriser.hpp"
+#include "ParallelPrimeCounter.hpp"
+#include "PrimeChecker.hpp"
+#include "PrimeSieve.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// The benchmarks run by default; their names tell how many numbers one run checks, so that the numbers
+// per second follow from the mean. To compare commits, keep the XML of each:
+//   helloworld-Bench -r xml -o bench.xml
+// The [throughput] and [scaling] test cases are hidden; they print numbers/s and the speed-up of the
+// parallel prime counting as semicolon separated lines.
+
+namespace {
+constexpr size_t NUMBERS{1 << 20};
+constexpr size_t LARGE_PRIMES{1024};
+constexpr uint32_t PASSES{64};
+constexpr size_t SEMIPRIMES{16};
+
+// Uniformly distributed numbers, fixed seed so that the runs are comparable
+template <typename Integer>
+std::vector<Integer> uniformNumbers(size_t count, uint64_t largest) {
+    std::mt19937_64 generator{42};
+    std::uniform_int_distribution<uint64_t> distribution{0, largest};
+    std::vector<Integer> numbers(count);
+    for (auto &n : numbers) {
+        n = static_cast<Integer>(distribution(generator));
+    }
+    return numbers;
+}
+
+// The largest primes below 2^bits, the worst case: trial division used to run longest for them, and the
+// Miller-Rabin test has to run all bases
+std::vector<uint64_t> largePrimes(uint32_t bits) {
+    PrimeChecker pc;
+    std::vector<uint64_t> primes;
+    for (uint64_t n{(64 == bits) ? UINT64_MAX : (static_cast<uint64_t>(1) << bits) - 1}; primes.size() < LARGE_PRIMES; n -= 2) {
+        if (pc.isPrime(n)) {
+            primes.push_back(n);
+        }
+    }
+    return primes;
+}
+
+// Products of two random primes of bits / 2 bits each, the hardest numbers of their size for the rho method
+std::vector<uint64_t> semiprimes(uint32_t bits) {
+    PrimeChecker pc;
+    std::mt19937_64 generator{42};
+    std::uniform_int_distribution<uint64_t> distribution{static_cast<uint64_t>(1) << (bits / 2 - 1), (static_cast<uint64_t>(1) << (bits / 2)) - 1};
+    auto prime = [&]{
+        uint64_t p{distribution(generator)};
+        while (!pc.isPrime(p)) {
+            p = distribution(generator);
+        }
+        return p;
+    };
+    std::vector<uint64_t> numbers(SEMIPRIMES);
+    for (auto &n : numbers) {
+        n = prime() * prime();
+    }
+    return numbers;
+}
+
+uint64_t countFactors(Factoriser &f, const std::vector<uint64_t> &numbers) {
+    uint64_t factors{0};
+    for (auto n : numbers) {
+        factors += f.factorise(n).size();
+    }
+    return factors;
+}
+
+template <typename Integer>
+uint64_t countScalar(PrimeChecker &pc, const std::vector<Integer> &numbers) {
+    uint64_t primes{0};
+    for (auto n : numbers) {
+        primes += pc.isPrime(n) ? 1 : 0;
+    }
+    return primes;
+}
+
+// Runs check PASSES times over the numbers and prints the numbers per second
+template <typename Check>
+void reportThroughput(const char *name, Check check, size_t numbers = NUMBERS) {
+    const auto begin = std::chrono::steady_clock::now();
+    uint64_t primes{0};
+    for (uint32_t pass{0}; pass < PASSES; pass++) {
+        primes += check();
+    }
+    const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+    std::cout << name << ";" << static_cast<uint64_t>(static_cast<double>(numbers) * PASSES / seconds) << " numbers/s;" << primes / PASSES << " primes" << std::endl;
+}
+}
+
+TEST_CASE("Scalar isPrime.", "[benchmark]") {
+    PrimeChecker pc;
+    const auto uniform16 = uniformNumbers<uint16_t>(NUMBERS, UINT16_MAX);
+    const auto large16 = largePrimes(16);
+    const auto uniform64 = uniformNumbers<uint64_t>(LARGE_PRIMES, UINT64_MAX);
+    const auto large32 = largePrimes(32);
+    const auto large64 = largePrimes(64);
+    std::vector<uint16_t> large16Narrow(large16.begin(), large16.end());
+    std::vector<uint32_t> large32Narrow(large32.begin(), large32.end());
+
+    BENCHMARK("uint16_t uniform (2^20 numbers)") { return countScalar(pc, uniform16); };
+    BENCHMARK("uint16_t largest primes (1024 numbers)") { return countScalar(pc, large16Narrow); };
+    BENCHMARK("uint32_t largest primes (1024 numbers)") { return countScalar(pc, large32Narrow); };
+    BENCHMARK("uint64_t uniform (1024 numbers)") { return countScalar(pc, uniform64); };
+    BENCHMARK("uint64_t largest primes (1024 numbers)") { return countScalar(pc, large64); };
+}
+
+TEST_CASE("Batch isPrime.", "[benchmark]") {
+    PrimeChecker pc;
+    const auto uniform16 = uniformNumbers<uint16_t>(NUMBERS, UINT16_MAX);
+    const auto uniform64 = uniformNumbers<uint64_t>(LARGE_PRIMES, UINT64_MAX);
+    std::vector<uint8_t> results(NUMBERS);
+    std::vector<uint8_t> bits(NUMBERS / 8);
+
+    BENCHMARK("uint16_t bytes (2^20 numbers)") {
+        pc.isPrime(uniform16.data(), uniform16.size(), results.data());
+        return results[0];
+    };
+    BENCHMARK("uint16_t packed (2^20 numbers)") {
+        pc.isPrimePacked(uniform16.data(), uniform16.size(), bits.data());
+        return bits[0];
+    };
+    BENCHMARK("uint64_t bytes (1024 numbers)") {
+        pc.isPrime(uniform64.data(), uniform64.size(), results.data());
+        return results[0];
+    };
+}
+
+TEST_CASE("PrimeSieve ranges.", "[benchmark]") {
+    PrimeSieve sieve;
+    BENCHMARK("count [0, 10^7)") { return sieve.countPrimes(0, 10000000); };
+    BENCHMARK("count [10^12, 10^12 + 10^7)") { return sieve.countPrimes(1000000000000ull, 1000010000000ull); };
+    BENCHMARK("visit [10^9, 10^9 + 10^7)") {
+        uint64_t sum{0};
+        sieve.forEachPrime(1000000000, 1010000000, [&sum](uint64_t p) { sum += p; });
+        return sum;
+    };
+}
+
+TEST_CASE("Factoriser semiprimes.", "[benchmark]") {
+    Factoriser f;
+    const auto semiprimes40 = semiprimes(40);
+    const auto semiprimes52 = semiprimes(52);
+    const auto semiprimes64 = semiprimes(64);
+    std::vector<std::vector<uint64_t>> factors(SEMIPRIMES);
+
+    BENCHMARK("40-bit semiprimes (16 numbers)") { return countFactors(f, semiprimes40); };
+    BENCHMARK("52-bit semiprimes (16 numbers)") { return countFactors(f, semiprimes52); };
+    BENCHMARK("64-bit semiprimes (16 numbers)") { return countFactors(f, semiprimes64); };
+    BENCHMARK("64-bit semiprimes, batch on all threads (16 numbers)") {
+        f.factorise(semiprimes64.data(), semiprimes64.size(), factors.data());
+        return factors[0].size();
+    };
+}
+
+TEST_CASE("Throughput of PrimeChecker.", "[.][throughput]") {
+    PrimeChecker pc;
+    const auto numbers = uniformNumbers<uint16_t>(NUMBERS, UINT16_MAX);
+    std::vector<uint8_t> results(NUMBERS);
+    std::vector<uint8_t> bits(NUMBERS / 8);
+
+    reportThroughput("scalar", [&]{ return countScalar(pc, numbers); });
+    reportThroughput("batch", [&]{
+        pc.isPrime(numbers.data(), numbers.size(), results.data());
+        uint64_t primes{0};
+        for (auto r : results) {
+            primes += r;
+        }
+        return primes;
+    });
+    reportThroughput("batch packed", [&]{
+        pc.isPrimePacked(numbers.data(), numbers.size(), bits.data());
+        uint64_t primes{0};
+        for (auto b : bits) {
+            primes += static_cast<uint64_t>(__builtin_popcount(b));
+        }
+        return primes;
+    });
+    const auto primes = largePrimes(64);
+    reportThroughput("64-bit primes", [&]{ return countScalar(pc, primes); }, primes.size());
+    Factoriser f;
+    const auto semiprimes64 = semiprimes(64);
+    reportThroughput("64-bit semiprimes factorised", [&]{ return countFactors(f, semiprimes64); }, semiprimes64.size());
+}
+
+TEST_CASE("Scaling of ParallelPrimeCounter.", "[.][scaling]") {
+    const uint64_t to{10000000000ull};
+    std::vector<uint32_t> threads{1, 2, 4, 8};
+    if (std::thread::hardware_concurrency() > 8) {
+        threads.push_back(std::thread::hardware_concurrency());
+    }
+    double single{0.0};
+    for (uint32_t count : threads) {
+        ParallelPrimeCounter counter{count};
+        const auto begin = std::chrono::steady_clock::now();
+        const uint64_t primes{counter.countPrimes(0, to)};
+        const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+        single = (1 == count) ? seconds : single;
+        std::cout << "count primes below 10^10;" << count << " threads;" << seconds << " s;speed-up " << single / seconds
+                  << ";" << counter.numberOfStolenChunks() << " stolen chunks;" << primes << " primes" << std::endl;
+    }
+}
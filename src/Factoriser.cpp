@@ -0,0 +1,178 @@
+#include "Factoriser.hpp"
+#include "Montgomery.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace {
+// The trial divisors: the odd primes below 1024, each with p^-1 mod 2^64 and (2^64 - 1) / p. For an odd n,
+// n * p^-1 mod 2^64 is n / p if p divides n and larger than (2^64 - 1) / p otherwise, so that a trial
+// division takes one multiplication.
+struct TrialDivisors {
+    static constexpr uint32_t BELOW{1024};
+    static constexpr uint32_t COUNT{171};
+    uint64_t primes[COUNT];
+    uint64_t inverses[COUNT];
+    uint64_t limits[COUNT];
+
+    constexpr TrialDivisors() : primes{}, inverses{}, limits{} {
+        uint32_t count{0};
+        for (uint64_t n{3}; n < BELOW; n += 2) {
+            bool prime{true};
+            for (uint64_t d{3}; prime && (d * d <= n); d += 2) {
+                prime = (0 != n % d);
+            }
+            if (prime) {
+                uint64_t x{n};
+                for (uint32_t i{0}; i < 5; i++) {
+                    x *= 2 - n * x;
+                }
+                primes[count] = n;
+                inverses[count] = x;
+                limits[count] = UINT64_MAX / n;
+                count++;
+            }
+        }
+    }
+};
+
+constexpr TrialDivisors TRIAL_DIVISORS{};
+static_assert((3 == TRIAL_DIVISORS.primes[0]) && (1021 == TRIAL_DIVISORS.primes[TrialDivisors::COUNT - 1]), "The trial divisors are broken.");
+
+// Numbers in the blocks that the threads take in turn: a few, as factorising one number may take
+// milliseconds
+constexpr size_t BLOCK{16};
+
+uint64_t greatestCommonDivisor(uint64_t a, uint64_t b) {
+    if ((0 == a) || (0 == b)) {
+        return a | b;
+    }
+    // Binary: the common powers of 2 first, then subtract the smaller odd number from the larger one
+    const uint32_t shift{static_cast<uint32_t>(__builtin_ctzll(a | b))};
+    a >>= __builtin_ctzll(a);
+    do {
+        b >>= __builtin_ctzll(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        b -= a;
+    } while (0 != b);
+    return a << shift;
+}
+}
+
+constexpr uint32_t TrialDivisors::BELOW;
+constexpr uint32_t TrialDivisors::COUNT;
+
+Factoriser::Factoriser(const PrimeChecker &checker)
+    : m_checker(checker) {
+}
+
+std::vector<uint64_t> Factoriser::factorise(uint64_t n) {
+    std::vector<uint64_t> factors;
+    if (0 == n) {
+        return factors;
+    }
+    factors.insert(factors.end(), static_cast<size_t>(__builtin_ctzll(n)), 2);
+    n >>= __builtin_ctzll(n);
+    for (uint32_t i{0}; (i < TrialDivisors::COUNT) && (TRIAL_DIVISORS.primes[i] * TRIAL_DIVISORS.primes[i] <= n); i++) {
+        for (uint64_t quotient{n * TRIAL_DIVISORS.inverses[i]}; quotient <= TRIAL_DIVISORS.limits[i]; quotient = n * TRIAL_DIVISORS.inverses[i]) {
+            factors.push_back(TRIAL_DIVISORS.primes[i]);
+            n = quotient;
+        }
+    }
+
+    // Without a factor below 1024, n is a prime below 1024^2; otherwise it is split until all parts are primes
+    const size_t large{factors.size()};
+    std::vector<uint64_t> composites;
+    if ((1 != n) && (n < static_cast<uint64_t>(TrialDivisors::BELOW) * TrialDivisors::BELOW)) {
+        factors.push_back(n);
+    }
+    else if (1 != n) {
+        composites.push_back(n);
+    }
+    while (!composites.empty()) {
+        const uint64_t m{composites.back()};
+        composites.pop_back();
+        if (m_checker.isPrime(m)) {
+            factors.push_back(m);
+        }
+        else {
+            const uint64_t d{pollardBrent(m)};
+            composites.push_back(d);
+            composites.push_back(m / d);
+        }
+    }
+    std::sort(factors.begin() + static_cast<std::ptrdiff_t>(large), factors.end());
+    return factors;
+}
+
+uint64_t Factoriser::pollardBrent(uint64_t n) {
+    // The differences of m steps share one gcd; the steps from the last gcd are gone through again if
+    // the product caught all factors at once
+    constexpr uint64_t STEPS{128};
+    const Montgomery mont{n};
+    for (uint64_t c{1};; c++) {
+        // x -> x^2 + c; the constant is in Montgomery form as well, which is just another constant
+        const uint64_t constant{mont.toMontgomery(c)};
+        auto next = [&mont, constant](uint64_t x) { return mont.add(mont.multiply(x, x), constant); };
+        uint64_t y{mont.one()};
+        uint64_t x{y};
+        uint64_t saved{y};
+        uint64_t product{mont.one()};
+        uint64_t g{1};
+        for (uint64_t r{1}; 1 == g; r *= 2) {
+            x = y;
+            for (uint64_t i{0}; i < r; i++) {
+                y = next(y);
+            }
+            for (uint64_t k{0}; (k < r) && (1 == g); k += STEPS) {
+                saved = y;
+                for (uint64_t i{0}; i < std::min(STEPS, r - k); i++) {
+                    y = next(y);
+                    product = mont.multiply(product, mont.subtract(x, y));
+                }
+                // The Montgomery form only adds a factor 2^64, which has no common divisor with n
+                g = greatestCommonDivisor(product, n);
+            }
+        }
+        if (n == g) {
+            do {
+                saved = next(saved);
+                g = greatestCommonDivisor(mont.subtract(x, saved), n);
+            } while (1 == g);
+        }
+        // Otherwise the cycles modulo all factors closed at once; try another polynomial
+        if (n != g) {
+            return g;
+        }
+    }
+}
+
+void Factoriser::factorise(const uint64_t *numbers, size_t count, std::vector<uint64_t> *factors, uint32_t threads) {
+    const size_t blocks{(count + BLOCK - 1) / BLOCK};
+    const uint32_t available{(0 != threads) ? threads : std::max<uint32_t>(std::thread::hardware_concurrency(), 1)};
+    const uint32_t workerCount{static_cast<uint32_t>(std::min<size_t>(available, blocks))};
+    std::atomic<size_t> nextBlock{0};
+    auto work = [&](Factoriser &factoriser) {
+        for (size_t block{nextBlock.fetch_add(1)}; block < blocks; block = nextBlock.fetch_add(1)) {
+            for (size_t i{block * BLOCK}; i < std::min(count, (block + 1) * BLOCK); i++) {
+                factors[i] = factoriser.factorise(numbers[i]);
+            }
+        }
+    };
+    // Every thread has its own copy of the checker; the calling thread is one of them
+    std::vector<Factoriser> factorisers(workerCount, *this);
+    std::vector<std::thread> workers;
+    for (uint32_t i{1}; i < workerCount; i++) {
+        workers.emplace_back(work, std::ref(factorisers[i]));
+    }
+    if (0 < workerCount) {
+        work(factorisers[0]);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef FACTORISER
+#define FACTORISER
+#include "PrimeChecker.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// Splits 64-bit numbers into their prime factors: trial division by the primes below 1024 first, then
+// Pollard's rho in Brent's variant in Montgomery arithmetic for what is left. The cofactors are tested
+// with the PrimeChecker, so that the rho method only runs on composites.
+class Factoriser {
+   public:
+    // The checker is copied, e.g. with its prime table
+    explicit Factoriser(const PrimeChecker &checker = PrimeChecker{});
+
+    // The prime factors of n in ascending order, as often as they divide n; none for 0 and 1
+    std::vector<uint64_t> factorise(uint64_t n);
+    // Factorises many numbers at once: factors[i] are the prime factors of numbers[i]. The numbers are
+    // handed out to the threads in small blocks as they get done; 0 threads are as many as the CPU has.
+    void factorise(const uint64_t *numbers, size_t count, std::vector<uint64_t> *factors, uint32_t threads = 0);
+
+   private:
+    // A non-trivial factor of the odd composite n without prime factors below 1024
+    static uint64_t pollardBrent(uint64_t n);
+
+   private:
+    PrimeChecker m_checker;
+};
+#endif
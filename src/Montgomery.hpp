@@ -0,0 +1,56 @@
+#ifndef MONTGOMERY
+#define MONTGOMERY
+#include <cstdint>
+// The hot functions are always inlined, also in the size-optimised (-Os) build where a call per
+// multiplication would cost more than the multiplication itself
+#define MONTGOMERY_INLINE inline __attribute__((always_inline))
+
+// Arithmetic modulo an odd 64-bit number in Montgomery form (a * 2^64 mod n), so that a multiplication
+// modulo n takes three multiplications instead of a 128-bit division
+class Montgomery {
+   public:
+    explicit Montgomery(uint64_t n) : m_n(n), m_inverse(inverse(n)), m_one((0 - n) % n), m_r2(static_cast<uint64_t>((static_cast<unsigned __int128>(m_one) * m_one) % n)) {}
+
+    uint64_t modulus() const { return m_n; }
+    // 1 and n - 1 in Montgomery form
+    uint64_t one() const { return m_one; }
+    uint64_t minusOne() const { return m_n - m_one; }
+
+    uint64_t toMontgomery(uint64_t a) const { return multiply(a % m_n, m_r2); }
+    uint64_t fromMontgomery(uint64_t a) const { return reduce(a); }
+
+    MONTGOMERY_INLINE uint64_t multiply(uint64_t a, uint64_t b) const { return reduce(static_cast<unsigned __int128>(a) * b); }
+    // Without branches as in reduce()
+    MONTGOMERY_INLINE uint64_t add(uint64_t a, uint64_t b) const {
+        const uint64_t sum{a + b};
+        return sum - (m_n & (0 - static_cast<uint64_t>((sum < a) || (sum >= m_n))));
+    }
+    MONTGOMERY_INLINE uint64_t subtract(uint64_t a, uint64_t b) const { return (a - b) + (m_n & (0 - static_cast<uint64_t>(a < b))); }
+
+   private:
+    // t / 2^64 mod n for t < n * 2^64: with m = t * n^-1 mod 2^64, the low halves of t and m * n are equal,
+    // so that the difference of the high halves is (t - m * n) / 2^64 in (-n, n)
+    MONTGOMERY_INLINE uint64_t reduce(unsigned __int128 t) const {
+        const uint64_t m{static_cast<uint64_t>(t) * m_inverse};
+        const uint64_t high{static_cast<uint64_t>(t >> 64)};
+        const uint64_t mn{static_cast<uint64_t>((static_cast<unsigned __int128>(m) * m_n) >> 64)};
+        // Without a branch: whether n is added back is unpredictable, and -Os would branch on it
+        return (high - mn) + (m_n & (0 - static_cast<uint64_t>(high < mn)));
+    }
+
+    // n^-1 mod 2^64 by Newton's iteration; every step doubles the correct bits, starting with 3 for odd n
+    static uint64_t inverse(uint64_t n) {
+        uint64_t x{n};
+        for (uint32_t i{0}; i < 5; i++) {
+            x *= 2 - n * x;
+        }
+        return x;
+    }
+
+   private:
+    uint64_t m_n;
+    uint64_t m_inverse;
+    uint64_t m_one;
+    uint64_t m_r2;
+};
+#endif
@@ -0,0 +1,112 @@
+#include "ParallelPrimeCounter.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+// Segments per chunk: enough to pay for setting up the sieving primes of a chunk, and small enough
+// that there are several chunks per thread to steal
+constexpr uint64_t SEGMENTS_PER_CHUNK{8};
+
+struct Chunk {
+    uint64_t from;
+    uint64_t to;
+};
+
+struct ChunkQueue {
+    std::mutex mutex{};
+    std::deque<Chunk> chunks{};
+};
+}
+
+ParallelPrimeCounter::ParallelPrimeCounter(uint32_t threads, size_t segmentBytes) {
+    const uint32_t count{(0 != threads) ? threads : std::max<uint32_t>(std::thread::hardware_concurrency(), 1)};
+    for (uint32_t i{0}; i < count; i++) {
+        m_sieves.emplace_back(new PrimeSieve{segmentBytes});
+    }
+}
+
+uint64_t ParallelPrimeCounter::countPrimes(uint64_t from, uint64_t to) {
+    m_stolen.store(0);
+    if (from >= to) {
+        return 0;
+    }
+    // A segment holds the odd numbers of twice its bits
+    const uint64_t chunkSize{SEGMENTS_PER_CHUNK * 16 * static_cast<uint64_t>(m_sieves.front()->segmentBytes())};
+    const uint64_t chunks{(to - from + chunkSize - 1) / chunkSize};
+    if ((1 == m_sieves.size()) || (1 == chunks)) {
+        return m_sieves.front()->countPrimes(from, to);
+    }
+
+    // Every thread starts with a contiguous block of chunks, so that its sieving primes stay warm
+    const uint32_t threads{static_cast<uint32_t>(std::min<uint64_t>(m_sieves.size(), chunks))};
+    std::unique_ptr<ChunkQueue[]> queues{new ChunkQueue[threads]};
+    for (uint64_t i{0}; i < chunks; i++) {
+        const uint64_t chunkFrom{from + i * chunkSize};
+        queues[i * threads / chunks].chunks.push_back(Chunk{chunkFrom, (to - chunkFrom > chunkSize) ? chunkFrom + chunkSize : to});
+    }
+
+    auto take = [&queues, threads](uint32_t own, Chunk &chunk, bool &stolen) {
+        {
+            std::lock_guard<std::mutex> lck(queues[own].mutex);
+            if (!queues[own].chunks.empty()) {
+                chunk = queues[own].chunks.front();
+                queues[own].chunks.pop_front();
+                stolen = false;
+                return true;
+            }
+        }
+        while (true) {
+            uint32_t victim{own};
+            size_t longest{0};
+            for (uint32_t i{0}; i < threads; i++) {
+                std::lock_guard<std::mutex> lck(queues[i].mutex);
+                if (queues[i].chunks.size() > longest) {
+                    longest = queues[i].chunks.size();
+                    victim = i;
+                }
+            }
+            if (0 == longest) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lck(queues[victim].mutex);
+            // The queue may have been emptied in the meantime; look again
+            if (!queues[victim].chunks.empty()) {
+                chunk = queues[victim].chunks.back();
+                queues[victim].chunks.pop_back();
+                stolen = true;
+                return true;
+            }
+        }
+    };
+
+    std::vector<uint64_t> counts(threads, 0);
+    auto work = [this, &take, &counts](uint32_t own) {
+        Chunk chunk{0, 0};
+        bool stolen{false};
+        uint64_t count{0};
+        while (take(own, chunk, stolen)) {
+            count += m_sieves[own]->countPrimes(chunk.from, chunk.to);
+            if (stolen) {
+                m_stolen.fetch_add(1);
+            }
+        }
+        counts[own] = count;
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i{1}; i < threads; i++) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    uint64_t total{0};
+    for (auto count : counts) {
+        total += count;
+    }
+    return total;
+}
@@ -0,0 +1,28 @@
+#ifndef PARALLELPRIMECOUNTER
+#define PARALLELPRIMECOUNTER
+#include "PrimeSieve.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+// Counts the primes of a range on several threads. The range is cut into chunks of a few segments; every
+// thread has its own sieve (segment buffer and sieving primes, kept between the calls) and a queue of
+// neighbouring chunks. A thread whose queue runs empty steals the last chunk of the longest other
+// queue, so that the threads finish together even if some of them are held up.
+class ParallelPrimeCounter {
+   public:
+    // 0 threads are as many as the CPU has
+    explicit ParallelPrimeCounter(uint32_t threads = 0, size_t segmentBytes = 0);
+
+    // Number of primes in [from, to)
+    uint64_t countPrimes(uint64_t from, uint64_t to);
+
+    uint32_t numberOfThreads() const { return static_cast<uint32_t>(m_sieves.size()); }
+    // Chunks of the last countPrimes that were sieved by another thread than the one they were queued for
+    uint64_t numberOfStolenChunks() const { return m_stolen.load(); }
+
+   private:
+    std::vector<std::unique_ptr<PrimeSieve>> m_sieves{};
+    std::atomic<uint64_t> m_stolen{0};
+};
+#endif
@@ -1,17 +1,324 @@
 #include "PrimeChecker.hpp"
+#include "Montgomery.hpp"
+#include "PrimeTable.hpp"
 
-bool PrimeChecker::isPrime(uint16_t n) {
-    bool retVal{true};
-    if (n<2 || 0 == n%2) {
-        retVal = false;
-    }
-    else {
-        for(uint16_t i{3}; (i*i) <= n; i += 2) {
-            if (0 == n%i) {
-                return false;
-                break;
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_PRIME_CHECKER_AVX2
+#endif
+
+namespace {
+// One bit per odd number of the uint16_t domain (4 KB), set for the odd primes; built by a sieve of
+// Eratosthenes at compile time, so that there is neither a startup cost nor a division per call.
+struct OddPrimeBitmap {
+    static constexpr uint32_t WORDS{(UINT16_MAX + 1) / 2 / 64};
+    uint64_t words[WORDS];
+
+    constexpr OddPrimeBitmap() : words{} {
+        for (uint32_t i{0}; i < WORDS; i++) {
+            words[i] = ~static_cast<uint64_t>(0);
+        }
+        // 1 is not a prime
+        words[0] &= ~static_cast<uint64_t>(1);
+        for (uint32_t p{3}; (p * p) <= UINT16_MAX; p += 2) {
+            if (isSet(p)) {
+                for (uint32_t multiple{p * p}; multiple <= UINT16_MAX; multiple += 2 * p) {
+                    words[multiple / 128] &= ~(static_cast<uint64_t>(1) << ((multiple / 2) % 64));
+                }
             }
         }
     }
-    return retVal;
+
+    // n must be odd
+    constexpr bool isSet(uint32_t n) const {
+        return 0 != ((words[n / 128] >> ((n / 2) % 64)) & 1);
+    }
+};
+
+constexpr OddPrimeBitmap ODD_PRIMES{};
+static_assert(ODD_PRIMES.isSet(3) && ODD_PRIMES.isSet(65521) && !ODD_PRIMES.isSet(65535), "The prime bitmap is broken.");
+
+// Without branches, so that the compiler may unroll and interleave the lookups of a batch; inlined also
+// with -Os, where a call would cost more than the lookup
+inline __attribute__((always_inline)) uint8_t lookup(uint16_t n) {
+    const uint32_t odd{static_cast<uint32_t>(n & 1)};
+    const uint32_t bit{static_cast<uint32_t>((ODD_PRIMES.words[n / 128] >> ((n / 2) % 64)) & 1)};
+    return static_cast<uint8_t>((bit & odd) | static_cast<uint32_t>(2 == n));
+}
+
+#ifdef HAVE_PRIME_CHECKER_AVX2
+bool haveAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// Eight numbers per step: the bitmap is read as 32-bit words with a gather, the bits are shifted per lane.
+// Returns the number of handled numbers (a multiple of 8); the rest is left to the scalar lookup.
+__attribute__((target("avx2"))) size_t lookupAvx2(const uint16_t *numbers, size_t count, uint8_t *results, uint8_t *bits) {
+    const int *words = reinterpret_cast<const int *>(ODD_PRIMES.words);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i two = _mm256_set1_epi32(2);
+    const __m256i thirtyOne = _mm256_set1_epi32(31);
+    size_t i{0};
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i n = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(numbers + i)));
+        // Bit n / 2 of the bitmap is bit (n / 2) % 32 of the 32-bit word n / 64 (little endian)
+        const __m256i word = _mm256_i32gather_epi32(words, _mm256_srli_epi32(n, 6), 4);
+        const __m256i bit = _mm256_srlv_epi32(word, _mm256_and_si256(_mm256_srli_epi32(n, 1), thirtyOne));
+        const __m256i prime = _mm256_or_si256(_mm256_and_si256(_mm256_and_si256(bit, n), one), _mm256_and_si256(_mm256_cmpeq_epi32(n, two), one));
+        if (nullptr != results) {
+            const __m128i shorts = _mm_packs_epi32(_mm256_castsi256_si128(prime), _mm256_extracti128_si256(prime, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(results + i), _mm_packus_epi16(shorts, shorts));
+        }
+        if (nullptr != bits) {
+            bits[i / 8] = static_cast<uint8_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(prime, one))));
+        }
+    }
+    return i;
+}
+
+const bool HAVE_AVX2{haveAvx2()};
+#endif
+
+// An odd n is divisible by the odd p if n * p^-1 mod 2^64 is at most (2^64 - 1) / p; this is one
+// multiplication, also where -Os would divide for n % p
+struct Divisor {
+    uint64_t inverse;
+    uint64_t limit;
+};
+
+constexpr Divisor divisor(uint64_t p) {
+    uint64_t x{p};
+    for (uint32_t i{0}; i < 5; i++) {
+        x *= 2 - p * x;
+    }
+    return Divisor{x, UINT64_MAX / p};
+}
+
+constexpr Divisor SMALL_PRIMES[]{divisor(3), divisor(5), divisor(7), divisor(11), divisor(13), divisor(17), divisor(19),
+                                 divisor(23), divisor(29), divisor(31), divisor(37), divisor(41), divisor(43), divisor(47), divisor(53)};
+
+// An odd number above 53 that is divisible by one of the small primes is not a prime; this sorts out
+// about three quarters of the odd composites before the exponentiations
+inline bool hasSmallFactor(uint64_t n) {
+    bool divisible{false};
+    for (const auto &p : SMALL_PRIMES) {
+        divisible |= (n * p.inverse) <= p.limit;
+    }
+    return divisible;
+}
+
+// Strong probable prime tests of the odd n > 53 to the given bases, which must be below n. The
+// exponentiations of all bases run in lockstep: they are independent, so the CPU overlaps their
+// multiplications instead of waiting for each.
+template <uint32_t BASES>
+bool isStrongProbablePrime(const Montgomery &mont, const uint64_t (&bases)[BASES]) {
+    const uint64_t n{mont.modulus()};
+    // n - 1 = d * 2^s with odd d
+    const uint32_t s{static_cast<uint32_t>(__builtin_ctzll(n - 1))};
+    const uint64_t d{(n - 1) >> s};
+
+    uint64_t x[BASES];
+    uint64_t power[BASES];
+    for (uint32_t b{0}; b < BASES; b++) {
+        x[b] = mont.one();
+        power[b] = mont.toMontgomery(bases[b]);
+    }
+    for (uint64_t e{d}; 0 != e; e >>= 1) {
+        if (0 != (e & 1)) {
+            for (uint32_t b{0}; b < BASES; b++) {
+                x[b] = mont.multiply(x[b], power[b]);
+            }
+        }
+        for (uint32_t b{0}; b < BASES; b++) {
+            power[b] = mont.multiply(power[b], power[b]);
+        }
+    }
+
+    for (uint32_t b{0}; b < BASES; b++) {
+        if ((mont.one() == x[b]) || (mont.minusOne() == x[b])) {
+            continue;
+        }
+        bool witness{true};
+        for (uint32_t r{1}; (r < s) && witness; r++) {
+            x[b] = mont.multiply(x[b], x[b]);
+            witness = (mont.minusOne() != x[b]);
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Jacobi symbol (a / n) for odd n
+int32_t jacobi(uint64_t a, uint64_t n) {
+    int32_t result{1};
+    a %= n;
+    while (0 != a) {
+        const uint32_t twos{static_cast<uint32_t>(__builtin_ctzll(a))};
+        a >>= twos;
+        // (2 / n) is -1 for n = 3 or 5 mod 8
+        if ((0 != (twos & 1)) && ((3 == (n & 7)) || (5 == (n & 7)))) {
+            result = -result;
+        }
+        // Quadratic reciprocity: the sign flips if both are 3 mod 4
+        if ((3 == (a & 3)) && (3 == (n & 3))) {
+            result = -result;
+        }
+        const uint64_t t{a};
+        a = n % a;
+        n = t;
+    }
+    return (1 == n) ? result : 0;
+}
+
+bool isSquare(uint64_t n) {
+    uint64_t root{static_cast<uint64_t>(std::sqrt(static_cast<double>(n)))};
+    // The double is off by a few for large n
+    while ((root > UINT32_MAX) || ((root * root) > n)) {
+        root--;
+    }
+    while (((root + 1) <= UINT32_MAX) && (((root + 1) * (root + 1)) <= n)) {
+        root++;
+    }
+    return (root * root) == n;
+}
+
+// Strong Lucas probable prime test of the odd n > 53 with Selfridge's parameters: the first D of
+// 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and Q = (1 - D) / 4. Together with the strong probable
+// prime test to base 2 this is the Baillie-PSW test, which has no false positive below 2^64 (checked
+// against the list of all base-2 strong pseudoprimes below 2^64 by Feitsma and Galway).
+bool isStrongLucasProbablePrime(const Montgomery &mont) {
+    const uint64_t n{mont.modulus()};
+    // A square has no D with (D / n) = -1
+    if (isSquare(n)) {
+        return false;
+    }
+    int64_t D{5};
+    for (int32_t symbol{jacobi(5, n)}; -1 != symbol; symbol = jacobi((D < 0) ? n - static_cast<uint64_t>(-D) : static_cast<uint64_t>(D), n)) {
+        // D and n have a common factor
+        if (0 == symbol) {
+            return false;
+        }
+        D = (D < 0) ? 2 - D : -2 - D;
+    }
+    const int64_t Q{(1 - D) / 4};
+    const uint64_t montQ{(Q < 0) ? mont.subtract(0, mont.toMontgomery(static_cast<uint64_t>(-Q))) : mont.toMontgomery(static_cast<uint64_t>(Q))};
+
+    // n + 1 = d * 2^s with odd d; n + 1 does not overflow as 2^64 - 1 is divisible by 3
+    const uint32_t s{static_cast<uint32_t>(__builtin_ctzll(n + 1))};
+    const uint64_t d{(n + 1) >> s};
+
+    // V_k, V_k+1, Q^k and Q^k+1 from k = 0 up to k = d with the bits of d from the top (P = 1):
+    //   V_2k = V_k^2 - 2 Q^k,  V_2k+1 = V_k V_k+1 - Q^k,  V_2k+2 = V_k+1^2 - 2 Q^k+1
+    // The bit selects the operands instead of a branch, which would mispredict on every other bit; the
+    // multiplications of a step are independent, so that a step takes about one multiplication.
+    uint64_t V{mont.add(mont.one(), mont.one())};
+    uint64_t V1{mont.one()};
+    uint64_t Qk{mont.one()};
+    uint64_t Qk1{montQ};
+    for (int32_t bit{63 - __builtin_clzll(d)}; bit >= 0; bit--) {
+        const uint64_t mask{0 - ((d >> bit) & 1)};
+        const uint64_t squared{(V1 & mask) | (V & ~mask)};
+        const uint64_t squaredQ{(Qk1 & mask) | (Qk & ~mask)};
+        const uint64_t cross{mont.subtract(mont.multiply(V, V1), Qk)};
+        const uint64_t square{mont.subtract(mont.multiply(squared, squared), mont.add(squaredQ, squaredQ))};
+        const uint64_t crossQ{mont.multiply(Qk, Qk1)};
+        const uint64_t squareQ{mont.multiply(squaredQ, squaredQ)};
+        V = (cross & mask) | (square & ~mask);
+        V1 = (square & mask) | (cross & ~mask);
+        Qk = (crossQ & mask) | (squareQ & ~mask);
+        Qk1 = (squareQ & mask) | (crossQ & ~mask);
+    }
+    // U_d = (2 V_d+1 - P V_d) / D
+    if ((mont.add(V1, V1) == V) || (0 == V)) {
+        return true;
+    }
+    // V_d 2^r = 0 for some 0 < r < s
+    for (uint32_t r{1}; r < s; r++) {
+        V = mont.subtract(mont.multiply(V, V), mont.add(Qk, Qk));
+        if (0 == V) {
+            return true;
+        }
+        Qk = mont.multiply(Qk, Qk);
+    }
+    return false;
+}
+
+// Bases for which the strong probable prime test has no false positive below 2^32 (Jaeschke)
+const uint64_t BASES_32[]{2, 7, 61};
+const uint64_t BASE_2[]{2};
+}
+
+bool PrimeChecker::loadTable(const std::string &path) {
+    std::shared_ptr<const PrimeTable> table{new PrimeTable{path}};
+    if (!table->valid()) {
+        return false;
+    }
+    m_table = table;
+    return true;
+}
+
+bool PrimeChecker::isPrime(uint16_t n) {
+    return 0 != lookup(n);
+}
+
+bool PrimeChecker::isPrime(uint32_t n) {
+    if (n <= UINT16_MAX) {
+        return 0 != lookup(static_cast<uint16_t>(n));
+    }
+    if (m_table && (n < m_table->limit())) {
+        return m_table->isPrime(n);
+    }
+    return (0 != (n & 1)) && !hasSmallFactor(n) && isStrongProbablePrime(Montgomery{n}, BASES_32);
+}
+
+bool PrimeChecker::isPrime(uint64_t n) {
+    if (n <= UINT32_MAX) {
+        return isPrime(static_cast<uint32_t>(n));
+    }
+    if ((0 == (n & 1)) || hasSmallFactor(n)) {
+        return false;
+    }
+    // Base 2 alone sorts out nearly all remaining composites; the Lucas test, which costs about two more
+    // bases, only runs for (probable) primes
+    const Montgomery mont{n};
+    return isStrongProbablePrime(mont, BASE_2) && isStrongLucasProbablePrime(mont);
+}
+
+void PrimeChecker::isPrime(const uint16_t *numbers, size_t count, uint8_t *results) {
+    size_t i{0};
+#ifdef HAVE_PRIME_CHECKER_AVX2
+    if (HAVE_AVX2) {
+        i = lookupAvx2(numbers, count, results, nullptr);
+    }
+#endif
+    for (; i < count; i++) {
+        results[i] = lookup(numbers[i]);
+    }
+}
+
+void PrimeChecker::isPrime(const uint64_t *numbers, size_t count, uint8_t *results) {
+    for (size_t i{0}; i < count; i++) {
+        results[i] = (numbers[i] <= UINT16_MAX) ? lookup(static_cast<uint16_t>(numbers[i])) : static_cast<uint8_t>(isPrime(numbers[i]));
+    }
+}
+
+void PrimeChecker::isPrimePacked(const uint16_t *numbers, size_t count, uint8_t *bits) {
+    size_t i{0};
+#ifdef HAVE_PRIME_CHECKER_AVX2
+    if (HAVE_AVX2) {
+        i = lookupAvx2(numbers, count, nullptr, bits);
+    }
+#endif
+    for (; i < count; i += 8) {
+        uint8_t byte{0};
+        for (size_t j{0}; (j < 8) && ((i + j) < count); j++) {
+            byte = static_cast<uint8_t>(byte | (lookup(numbers[i + j]) << j));
+        }
+        bits[i / 8] = byte;
+    }
 }
@@ -0,0 +1,214 @@
+#include "PrimeSieve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+// The residues modulo 210 that are coprime to 2, 3, 5 and 7, and for every residue the position of the
+// next coprime one; the multiples p * k with such k are the only ones left to cross off for p >= 11
+struct Wheel {
+    static constexpr uint32_t SIZE{48};
+    uint32_t residues[SIZE];
+    // Distance to the next coprime residue in bits (odd numbers)
+    uint32_t steps[SIZE];
+    // Position of the smallest coprime residue >= r; SIZE if there is none below 210
+    uint32_t positions[210];
+
+    constexpr Wheel() : residues{}, steps{}, positions{} {
+        uint32_t count{0};
+        for (uint32_t r{0}; r < 210; r++) {
+            positions[r] = count;
+            if ((0 != r % 2) && (0 != r % 3) && (0 != r % 5) && (0 != r % 7)) {
+                residues[count++] = r;
+            }
+        }
+        for (uint32_t i{0}; i < SIZE; i++) {
+            steps[i] = (((i + 1 < SIZE) ? residues[i + 1] : 210 + residues[0]) - residues[i]) / 2;
+        }
+    }
+};
+
+constexpr Wheel WHEEL{};
+
+// The odd numbers that are not multiples of 3, 5 or 7; as bit g stands for 2 * g + 1, the pattern
+// repeats every 105 bits and thus every 105 words
+struct Pattern {
+    static constexpr uint32_t WORDS{105};
+    uint64_t words[WORDS];
+
+    constexpr Pattern() : words{} {
+        for (uint32_t g{0}; g < 64 * WORDS; g++) {
+            const uint32_t n{2 * g + 1};
+            if ((0 != n % 3) && (0 != n % 5) && (0 != n % 7)) {
+                words[g / 64] |= static_cast<uint64_t>(1) << (g % 64);
+            }
+        }
+    }
+};
+
+constexpr Pattern PATTERN{};
+
+uint64_t squareRoot(uint64_t n) {
+    uint64_t root{static_cast<uint64_t>(std::sqrt(static_cast<double>(n)))};
+    while ((root > 0) && (root > n / root)) {
+        root--;
+    }
+    while ((root + 1) <= n / (root + 1)) {
+        root++;
+    }
+    return root;
+}
+
+// Sizes like "2048K" from /sys/devices/system/cpu/cpu0/cache/index<i>/size
+size_t readCacheSize(uint32_t index, uint32_t level) {
+    const std::string directory{"/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/"};
+    std::ifstream levelFile{directory + "level"};
+    std::ifstream typeFile{directory + "type"};
+    std::ifstream sizeFile{directory + "size"};
+    uint32_t cacheLevel{0};
+    std::string type;
+    size_t size{0};
+    char unit{0};
+    if ((levelFile >> cacheLevel) && (typeFile >> type) && (sizeFile >> size) && (cacheLevel == level) && ("Instruction" != type)) {
+        if ((sizeFile >> unit) && ('K' == unit)) {
+            size *= 1024;
+        }
+        else if ('M' == unit) {
+            size *= 1024 * 1024;
+        }
+        return size;
+    }
+    return 0;
+}
+}
+
+constexpr uint32_t Wheel::SIZE;
+constexpr uint32_t Pattern::WORDS;
+
+PrimeSieve::PrimeSieve(size_t segmentBytes)
+    : m_segment(std::max<size_t>(((0 == segmentBytes) ? cacheSize() / 2 : segmentBytes) / sizeof(uint64_t), 1)) {
+}
+
+size_t PrimeSieve::cacheSize() {
+    for (uint32_t level : {2, 1}) {
+        for (uint32_t index{0}; index < 8; index++) {
+            const size_t size{readCacheSize(index, level)};
+            if (0 != size) {
+                return size;
+            }
+        }
+    }
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    const long size{::sysconf(_SC_LEVEL2_CACHE_SIZE)};
+    if (0 < size) {
+        return static_cast<size_t>(size);
+    }
+#endif
+    return 256 * 1024;
+}
+
+uint64_t PrimeSieve::countPrimes(uint64_t from, uint64_t to) {
+    uint64_t count{0};
+    for (uint64_t p : {2, 3, 5, 7}) {
+        count += ((from <= p) && (p < to)) ? 1 : 0;
+    }
+    sieve(from, to, [&count](uint64_t, const uint64_t *words, size_t wordCount) {
+        for (size_t i{0}; i < wordCount; i++) {
+            count += static_cast<uint64_t>(__builtin_popcountll(words[i]));
+        }
+    });
+    return count;
+}
+
+void PrimeSieve::addSievingPrimes(uint64_t limit) {
+    // A plain sieve of the odd numbers up to limit; odd[i] stands for 2 * i + 1
+    std::vector<uint8_t> odd(limit / 2 + 1, 1);
+    for (uint64_t i{1}; (2 * i + 1) * (2 * i + 1) <= limit; i++) {
+        if (0 != odd[i]) {
+            const uint64_t p{2 * i + 1};
+            for (uint64_t j{p * p / 2}; j < odd.size(); j += p) {
+                odd[j] = 0;
+            }
+        }
+    }
+    m_primes.clear();
+    for (uint64_t i{5}; (i < odd.size()) && ((2 * i + 1) <= limit); i++) {
+        if (0 != odd[i]) {
+            m_primes.push_back(static_cast<uint32_t>(2 * i + 1));
+        }
+    }
+    m_primesUpTo = limit;
+}
+
+void PrimeSieve::sieve(uint64_t from, uint64_t to, const std::function<void(uint64_t, const uint64_t *, size_t)> &visit) {
+    // Bit g stands for the odd number 2 * g + 1; the odd numbers of [from, to) are the bits [first, last)
+    const uint64_t first{from / 2};
+    const uint64_t last{to / 2};
+    if (first >= last) {
+        return;
+    }
+    const uint64_t largest{squareRoot(to - 1)};
+    // Grow the sieving primes in steps, so that ranges that slowly move up do not sieve them again and again
+    if (largest > m_primesUpTo) {
+        addSievingPrimes(std::max<uint64_t>(largest, 2 * m_primesUpTo));
+    }
+
+    // Segments start at a word, so that the pattern can be copied word by word
+    uint64_t segmentStart{first & ~static_cast<uint64_t>(63)};
+    m_sieving.clear();
+    for (uint32_t p : m_primes) {
+        if (p > largest) {
+            break;
+        }
+        // The first multiple p * k >= p * p at or after the segment with k coprime to 210
+        const uint64_t number{2 * segmentStart + 1};
+        const uint64_t k0{std::max<uint64_t>(p, (number + p - 1) / p)};
+        const uint32_t position{WHEEL.positions[k0 % 210]};
+        const uint32_t wheel{(Wheel::SIZE == position) ? 0 : position};
+        const uint64_t k{k0 - k0 % 210 + ((Wheel::SIZE == position) ? 210 : 0) + WHEEL.residues[wheel]};
+        m_sieving.push_back(SievingPrime{p, wheel, (p * k) / 2 - segmentStart});
+    }
+
+    uint32_t patternWord{static_cast<uint32_t>((segmentStart / 64) % Pattern::WORDS)};
+    uint64_t *segment{m_segment.data()};
+    while (segmentStart < last) {
+        const size_t words{static_cast<size_t>(std::min<uint64_t>(m_segment.size(), (last - segmentStart + 63) / 64))};
+        const uint64_t bits{64 * static_cast<uint64_t>(words)};
+        for (size_t i{0}; i < words; i++) {
+            segment[i] = PATTERN.words[patternWord];
+            patternWord = (Pattern::WORDS == patternWord + 1) ? 0 : patternWord + 1;
+        }
+        if (0 == segmentStart) {
+            // 1 is not a prime
+            segment[0] &= ~static_cast<uint64_t>(1);
+        }
+
+        for (auto &sievingPrime : m_sieving) {
+            uint64_t next{sievingPrime.next};
+            uint32_t wheel{sievingPrime.wheel};
+            const uint64_t p{sievingPrime.prime};
+            while (next < bits) {
+                segment[next / 64] &= ~(static_cast<uint64_t>(1) << (next % 64));
+                next += p * WHEEL.steps[wheel];
+                wheel = (Wheel::SIZE == wheel + 1) ? 0 : wheel + 1;
+            }
+            sievingPrime.next = next - bits;
+            sievingPrime.wheel = wheel;
+        }
+
+        // Only the bits of [first, last)
+        if (segmentStart < first) {
+            segment[0] &= ~static_cast<uint64_t>(0) << (first - segmentStart);
+        }
+        if (segmentStart + bits > last) {
+            const uint64_t keep{last - (segmentStart + bits - 64)};
+            segment[words - 1] &= (64 == keep) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << keep) - 1);
+        }
+
+        visit(2 * segmentStart + 1, segment, words);
+        segmentStart += bits;
+    }
+}
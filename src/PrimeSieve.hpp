@@ -0,0 +1,64 @@
+#ifndef PRIMESIEVE
+#define PRIMESIEVE
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+// Finds the primes of a range with a segmented sieve of Eratosthenes: the odd numbers of a segment are
+// one bit each and a segment fits into the L2 cache. The multiples of 3, 5 and 7 are copied in from a
+// pattern, and the larger primes only cross off their multiples that are coprime to 210 (a wheel).
+// The primes are handed out segment by segment, so that a range never has to fit into memory; the
+// memory for the sieving primes grows with the square root of the end of the range.
+class PrimeSieve {
+   public:
+    // A segment of 0 bytes is sized to the L2 cache
+    explicit PrimeSieve(size_t segmentBytes = 0);
+
+    // Calls visit(p) for every prime p in [from, to) in ascending order
+    template <typename Visitor>
+    void forEachPrime(uint64_t from, uint64_t to, Visitor visit);
+    // Number of primes in [from, to)
+    uint64_t countPrimes(uint64_t from, uint64_t to);
+
+    size_t segmentBytes() const { return m_segment.size() * sizeof(uint64_t); }
+    // Size of the L2 cache (or the L1 data cache, if there is no L2) as told by the OS; 256 KB if unknown
+    static size_t cacheSize();
+
+   private:
+    // Calls visit(first, words, count) for every segment of [from, to): bit i of the words is set if
+    // first + 2 * i is a prime; 2, 3, 5 and 7 are left out
+    void sieve(uint64_t from, uint64_t to, const std::function<void(uint64_t, const uint64_t *, size_t)> &visit);
+    // Extends the sieving primes (from 11 on) up to limit
+    void addSievingPrimes(uint64_t limit);
+
+   private:
+    struct SievingPrime {
+        uint32_t prime;
+        // Position of the next multiple in the wheel
+        uint32_t wheel;
+        // Bit of the next multiple, counted from the beginning of the current segment
+        uint64_t next;
+    };
+
+    std::vector<uint64_t> m_segment;
+    std::vector<uint32_t> m_primes{};
+    uint64_t m_primesUpTo{0};
+    std::vector<SievingPrime> m_sieving{};
+};
+
+template <typename Visitor>
+void PrimeSieve::forEachPrime(uint64_t from, uint64_t to, Visitor visit) {
+    for (uint64_t p : {2, 3, 5, 7}) {
+        if ((from <= p) && (p < to)) {
+            visit(p);
+        }
+    }
+    sieve(from, to, [&visit](uint64_t first, const uint64_t *words, size_t count) {
+        for (size_t i{0}; i < count; i++) {
+            for (uint64_t word{words[i]}; 0 != word; word &= word - 1) {
+                visit(first + 2 * (64 * i + static_cast<uint64_t>(__builtin_ctzll(word))));
+            }
+        }
+    });
+}
+#endif
@@ -0,0 +1,100 @@
+#include "PrimeTable.hpp"
+#include "PrimeSieve.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr uint32_t PrimeTable::VERSION;
+constexpr uint64_t PrimeTable::MAXIMUM_LIMIT;
+
+namespace {
+constexpr char MAGIC[8]{'P', 'R', 'I', 'M', 'E', 'T', 'B', 'L'};
+constexpr uint32_t ORDER_MARK{0x01020304};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t limit;
+    uint64_t reserved[5];
+};
+static_assert(64 == sizeof(Header), "The header of the prime table shall keep the bitmap aligned.");
+
+// Bytes of the bitmap for the odd numbers below limit, in whole words
+uint64_t bitmapSize(uint64_t limit) {
+    return ((limit / 2 + 63) / 64) * sizeof(uint64_t);
+}
+}
+
+PrimeTable::PrimeTable(const std::string &path) {
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (0 > fd) {
+        return;
+    }
+    struct stat status;
+    Header header;
+    if ((0 == ::fstat(fd, &status)) && (sizeof(Header) == ::pread(fd, &header, sizeof(Header), 0)) &&
+        (0 == std::memcmp(header.magic, MAGIC, sizeof(MAGIC))) && (VERSION == header.version) && (ORDER_MARK == header.byteOrder) &&
+        (header.limit <= MAXIMUM_LIMIT) && (static_cast<uint64_t>(status.st_size) == sizeof(Header) + bitmapSize(header.limit))) {
+        void *mapping{::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0)};
+        if (MAP_FAILED != mapping) {
+            // Lookups jump around; reading ahead would only load pages that nobody asks for
+            ::madvise(mapping, static_cast<size_t>(status.st_size), MADV_RANDOM);
+            m_mapping = mapping;
+            m_size = static_cast<size_t>(status.st_size);
+            m_words = reinterpret_cast<const uint64_t *>(static_cast<const char *>(mapping) + sizeof(Header));
+            m_limit = header.limit;
+        }
+    }
+    // The mapping stays valid without the file descriptor
+    ::close(fd);
+}
+
+PrimeTable::~PrimeTable() {
+    if (nullptr != m_mapping) {
+        ::munmap(m_mapping, m_size);
+    }
+}
+
+bool PrimeTable::generate(const std::string &path, uint64_t limit) {
+    if (limit > MAXIMUM_LIMIT) {
+        return false;
+    }
+    // Written to a temporary file that replaces the table at the end, so that readers never see half a table
+    const std::string temporary{path + ".tmp"};
+    const int fd{::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (0 > fd) {
+        return false;
+    }
+    const size_t size{static_cast<size_t>(sizeof(Header) + bitmapSize(limit))};
+    bool ok{0 == ::ftruncate(fd, static_cast<off_t>(size))};
+    void *mapping{ok ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED};
+    ok = (MAP_FAILED != mapping);
+    if (ok) {
+        // The file is all zeros after ftruncate; only the primes are set
+        uint64_t *words{reinterpret_cast<uint64_t *>(static_cast<char *>(mapping) + sizeof(Header))};
+        PrimeSieve sieve;
+        sieve.forEachPrime(3, limit, [words](uint64_t p) {
+            words[p / 128] |= static_cast<uint64_t>(1) << ((p / 2) % 64);
+        });
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = ORDER_MARK;
+        header.limit = limit;
+        std::memcpy(mapping, &header, sizeof(header));
+        ok = (0 == ::msync(mapping, size, MS_SYNC));
+        ::munmap(mapping, size);
+    }
+    ok = (0 == ::close(fd)) && ok;
+    ok = ok && (0 == ::rename(temporary.c_str(), path.c_str()));
+    if (!ok) {
+        ::unlink(temporary.c_str());
+    }
+    return ok;
+}
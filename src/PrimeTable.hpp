@@ -0,0 +1,43 @@
+#ifndef PRIMETABLE
+#define PRIMETABLE
+#include <cstddef>
+#include <cstdint>
+#include <string>
+// A precomputed prime bitmap in a file: one bit per odd number below a limit of up to 2^32 (256 MB for
+// the whole uint32_t range). The file is mapped and not read: a page is only loaded when a number on it
+// is looked up, so that opening the table costs next to nothing and processes share it in the page cache.
+//
+// File format (version 1), all numbers in the byte order of the machine that wrote it:
+//   char magic[8] = "PRIMETBL", uint32_t version, uint32_t byteOrder = 0x01020304, uint64_t limit,
+//   uint64_t reserved[5], then the bitmap as uint64_t words: bit g stands for 2 * g + 1.
+class PrimeTable {
+   private:
+    PrimeTable(const PrimeTable &) = delete;
+    PrimeTable(PrimeTable &&)      = delete;
+    PrimeTable &operator=(const PrimeTable &) = delete;
+    PrimeTable &operator=(PrimeTable &&) = delete;
+
+   public:
+    static constexpr uint32_t VERSION{1};
+    static constexpr uint64_t MAXIMUM_LIMIT{static_cast<uint64_t>(1) << 32};
+
+    explicit PrimeTable(const std::string &path);
+    ~PrimeTable();
+
+    bool valid() const { return nullptr != m_words; }
+    // The table answers for the numbers below the limit
+    uint64_t limit() const { return m_limit; }
+    bool isPrime(uint64_t n) const {
+        return (2 == n) || ((0 != (n & 1)) && (0 != ((m_words[n / 128] >> ((n / 2) % 64)) & 1)));
+    }
+
+    // Writes the table for the numbers below limit with the segmented sieve
+    static bool generate(const std::string &path, uint64_t limit = MAXIMUM_LIMIT);
+
+   private:
+    void *m_mapping{nullptr};
+    size_t m_size{0};
+    const uint64_t *m_words{nullptr};
+    uint64_t m_limit{0};
+};
+#endif
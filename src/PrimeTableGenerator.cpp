@@ -0,0 +1,33 @@
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "PrimeTable.hpp"
+
+int main(int argc, char** argv) {
+    // The limit is a decimal number up to the largest limit; strtoull alone would take "-1", "12abc" or
+    // an overflow as some other limit
+    uint64_t limit{PrimeTable::MAXIMUM_LIMIT};
+    bool valid{(2 == argc) || (3 == argc)};
+    if (valid && (3 == argc)) {
+        char *end{nullptr};
+        errno = 0;
+        limit = std::strtoull(argv[2], &end, 10);
+        valid = std::isdigit(static_cast<unsigned char>(argv[2][0])) && ('\0' == *end) && (0 == errno) && (limit <= PrimeTable::MAXIMUM_LIMIT);
+    }
+    if (!valid) {
+        std::cerr << argv[0] << " writes the prime table for helloworld --table=<file>." << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <file> [<limit>]" << std::endl;
+        std::cerr << "         <limit>: the table answers for the numbers below it (default and at most: " << PrimeTable::MAXIMUM_LIMIT << ")" << std::endl;
+        return 1;
+    }
+    const auto begin = std::chrono::steady_clock::now();
+    if (!PrimeTable::generate(argv[1], limit)) {
+        std::cerr << argv[0] << ": Failed to write " << argv[1] << "." << std::endl;
+        return 1;
+    }
+    std::cerr << argv[0] << ": Wrote the primes below " << limit << " to " << argv[1] << " in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << " s." << std::endl;
+    return 0;
+}
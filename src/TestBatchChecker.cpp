@@ -0,0 +1,123 @@
+#include "catch.hpp"
+#include "BatchChecker.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+// Everything written to the file so far
+std::string readBack(FILE *file) {
+    std::string contents;
+    char buffer[4096];
+    ::lseek(fileno(file), 0, SEEK_SET);
+    for (ssize_t got{0}; 0 < (got = ::read(fileno(file), buffer, sizeof(buffer)));) {
+        contents.append(buffer, static_cast<size_t>(got));
+    }
+    return contents;
+}
+}
+
+TEST_CASE("Test BatchChecker with text split at every byte.") {
+    const std::string input{"2\n7919 65536\r\n-5,18446744073709551557\n99999999999999999999 - x 4"};
+    const std::string expected{"2;1\n7919;1\n65536;0\n-5;0\n18446744073709551557;1\n99999999999999999999;0\n4;0\n"};
+    for (size_t split{1}; split <= input.size(); split++) {
+        FILE *file{std::tmpfile()};
+        REQUIRE(nullptr != file);
+        {
+            BatchChecker checker{BatchChecker::Format::Text, fileno(file)};
+            // As if the input came in reads of split bytes; unused bytes are fed again with the next read
+            std::string pending;
+            for (size_t offset{0}; offset < input.size(); offset += split) {
+                pending += input.substr(offset, split);
+                const bool last{(offset + split) >= input.size()};
+                pending.erase(0, checker.feed(pending.data(), pending.size(), last));
+            }
+            REQUIRE(pending.empty());
+            REQUIRE(7 == checker.numberOfNumbers());
+            REQUIRE(3 == checker.numberOfPrimes());
+            REQUIRE(1 == checker.numberOfInvalidNumbers());
+        }
+        REQUIRE(expected == readBack(file));
+        std::fclose(file);
+    }
+}
+
+TEST_CASE("Test BatchChecker with binary numbers.") {
+    FILE *file{std::tmpfile()};
+    REQUIRE(nullptr != file);
+    const uint64_t numbers[]{1, 2, 65521, 4294967291u, 18446744073709551557ull, 18446744073709551615ull};
+    char input[sizeof(numbers) + 3];
+    for (size_t i{0}; i < 6; i++) {
+        for (size_t b{0}; b < 8; b++) {
+            input[8 * i + b] = static_cast<char>(numbers[i] >> (8 * b));
+        }
+    }
+    {
+        BatchChecker checker{BatchChecker::Format::Binary, fileno(file)};
+        // Stops at the incomplete number until the last data
+        REQUIRE(sizeof(numbers) == checker.feed(input, sizeof(input), false));
+        REQUIRE(3 == checker.feed(input + sizeof(numbers), 3, true));
+        REQUIRE(6 == checker.numberOfNumbers());
+        REQUIRE(1 == checker.numberOfInvalidNumbers());
+    }
+    REQUIRE(std::string("\0\1\1\1\1\0", 6) == readBack(file));
+    std::fclose(file);
+}
+
+TEST_CASE("Test BatchChecker when a signal interrupts the write.") {
+    int fds[2];
+    REQUIRE(0 == ::pipe(fds));
+    // Fill the pipe, so that the results cannot be written before the reader starts
+    size_t filled{0};
+    {
+        ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        const char zeros[4096]{};
+        for (ssize_t written{0}; 0 < (written = ::write(fds[1], zeros, sizeof(zeros)));) {
+            filled += static_cast<size_t>(written);
+        }
+        ::fcntl(fds[1], F_SETFL, 0);
+    }
+    // Without SA_RESTART, the blocked write() fails with EINTR
+    struct sigaction action{};
+    struct sigaction previous{};
+    action.sa_handler = [](int) {};
+    REQUIRE(0 == ::sigaction(SIGUSR1, &action, &previous));
+
+    const pthread_t writer{::pthread_self()};
+    std::string contents;
+    std::thread reader{[&]{
+        for (uint32_t i{0}; i < 5; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ::pthread_kill(writer, SIGUSR1);
+        }
+        char buffer[4096];
+        for (ssize_t got{0}; 0 < (got = ::read(fds[0], buffer, sizeof(buffer)));) {
+            contents.append(buffer, static_cast<size_t>(got));
+        }
+    }};
+    {
+        const uint64_t numbers[]{2, 4, 65521, 18446744073709551557ull};
+        char input[sizeof(numbers)];
+        for (size_t i{0}; i < 4; i++) {
+            for (size_t b{0}; b < 8; b++) {
+                input[8 * i + b] = static_cast<char>(numbers[i] >> (8 * b));
+            }
+        }
+        BatchChecker checker{BatchChecker::Format::Binary, fds[1]};
+        checker.feed(input, sizeof(input), true);
+        CHECK(checker.flush());
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    ::sigaction(SIGUSR1, &previous, nullptr);
+    REQUIRE((filled + 4) == contents.size());
+    REQUIRE(std::string("\1\0\1\1", 4) == contents.substr(filled));
+}
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+#include "Factoriser.hpp"
+#include "PrimeChecker.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+// The factors are primes in ascending order and multiply up to n
+bool isFactorisation(PrimeChecker &pc, uint64_t n, const std::vector<uint64_t> &factors) {
+    unsigned __int128 product{1};
+    for (size_t i{0}; i < factors.size(); i++) {
+        if (!pc.isPrime(factors[i]) || ((0 < i) && (factors[i - 1] > factors[i]))) {
+            return false;
+        }
+        product *= factors[i];
+    }
+    return (0 == n) ? factors.empty() : (product == n);
+}
+}
+
+TEST_CASE("Test Factoriser with known factorisations.") {
+    Factoriser f;
+    REQUIRE(f.factorise(0).empty());
+    REQUIRE(f.factorise(1).empty());
+    REQUIRE((std::vector<uint64_t>{2}) == f.factorise(2));
+    REQUIRE((std::vector<uint64_t>{2, 2, 3, 7, 1021}) == f.factorise(4 * 3 * 7 * 1021));
+    REQUIRE((std::vector<uint64_t>{1031, 1031}) == f.factorise(1031 * 1031));
+    REQUIRE((std::vector<uint64_t>(63, 2)) == f.factorise(static_cast<uint64_t>(1) << 63));
+    REQUIRE((std::vector<uint64_t>{3, 5, 17, 257, 641, 65537, 6700417}) == f.factorise(UINT64_MAX));
+    REQUIRE((std::vector<uint64_t>{18446744073709551557ull}) == f.factorise(18446744073709551557ull));
+    REQUIRE((std::vector<uint64_t>{4294967279ull, 4294967291ull}) == f.factorise(4294967279ull * 4294967291ull));
+    REQUIRE((std::vector<uint64_t>{4294967291ull, 4294967291ull}) == f.factorise(4294967291ull * 4294967291ull));
+    REQUIRE((std::vector<uint64_t>{1048573, 1048573, 1048573}) == f.factorise(1048573ull * 1048573ull * 1048573ull));
+}
+
+TEST_CASE("Test Factoriser with small and random numbers.") {
+    PrimeChecker pc;
+    Factoriser f;
+    for (uint64_t n{0}; n < 100000; n++) {
+        REQUIRE(isFactorisation(pc, n, f.factorise(n)));
+    }
+    std::mt19937_64 generator{42};
+    for (uint32_t i{0}; i < 2000; i++) {
+        const uint64_t n{generator()};
+        REQUIRE(isFactorisation(pc, n, f.factorise(n)));
+    }
+}
+
+TEST_CASE("Test Factoriser in batches.") {
+    std::mt19937_64 generator{7};
+    std::vector<uint64_t> numbers(1000);
+    for (auto &n : numbers) {
+        n = generator() >> (generator() % 64);
+    }
+    Factoriser f;
+    for (uint32_t threads : {1, 3, 8}) {
+        std::vector<std::vector<uint64_t>> factors(numbers.size());
+        f.factorise(numbers.data(), numbers.size(), factors.data(), threads);
+        for (size_t i{0}; i < numbers.size(); i++) {
+            REQUIRE(f.factorise(numbers[i]) == factors[i]);
+        }
+    }
+    // Nothing to do
+    f.factorise(numbers.data(), 0, nullptr);
+}
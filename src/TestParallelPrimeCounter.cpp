@@ -0,0 +1,17 @@
+#include "catch.hpp"
+#include "ParallelPrimeCounter.hpp"
+#include "PrimeSieve.hpp"
+
+TEST_CASE("Test ParallelPrimeCounter against PrimeSieve.") {
+    PrimeSieve sieve;
+    // Small segments, so that there are many chunks to share and steal
+    for (uint32_t threads : {1, 2, 3, 8}) {
+        ParallelPrimeCounter counter{threads, 4096};
+        REQUIRE(threads == counter.numberOfThreads());
+        REQUIRE(0 == counter.countPrimes(100, 100));
+        REQUIRE(4 == counter.countPrimes(0, 10));
+        REQUIRE(664579 == counter.countPrimes(0, 10000000));
+        REQUIRE(sieve.countPrimes(123456789, 133456789) == counter.countPrimes(123456789, 133456789));
+        REQUIRE(sieve.countPrimes(1000000000000ull, 1000010000000ull) == counter.countPrimes(1000000000000ull, 1000010000000ull));
+    }
+}
@@ -3,7 +3,143 @@
 #include "catch.hpp"
 #include "PrimeChecker.hpp"
 
+#include <random>
+#include <vector>
+
 TEST_CASE("Test PrimeChecker 1.") {
     PrimeChecker pc;
     REQUIRE(pc.isPrime(5));
 }
+
+// Trial division as PrimeChecker did it before the bitmap, except that 2 is a prime
+static bool isPrimeByTrialDivision(uint16_t n) {
+    if (2 == n) {
+        return true;
+    }
+    if (n < 2 || 0 == n % 2) {
+        return false;
+    }
+    for (uint32_t i{3}; (i * i) <= n; i += 2) {
+        if (0 == n % i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Test PrimeChecker against trial division for every uint16_t.") {
+    PrimeChecker pc;
+    uint32_t primes{0};
+    for (uint32_t n{0}; n <= UINT16_MAX; n++) {
+        const bool expected{isPrimeByTrialDivision(static_cast<uint16_t>(n))};
+        if (expected != pc.isPrime(static_cast<uint16_t>(n))) {
+            FAIL("isPrime(" << n << ") should be " << expected);
+        }
+        primes += expected ? 1 : 0;
+    }
+    REQUIRE(6542 == primes);
+}
+
+TEST_CASE("Test PrimeChecker at the edges.") {
+    PrimeChecker pc;
+    REQUIRE_FALSE(pc.isPrime(0));
+    REQUIRE_FALSE(pc.isPrime(1));
+    REQUIRE(pc.isPrime(2));
+    REQUIRE(pc.isPrime(3));
+    REQUIRE_FALSE(pc.isPrime(65535));
+    REQUIRE(pc.isPrime(65521));
+}
+
+TEST_CASE("Test the batch PrimeChecker against the scalar one.") {
+    PrimeChecker pc;
+    // Every uint16_t, shifted by one so that the vectorised part and the remainder see odd and even numbers
+    std::vector<uint16_t> numbers;
+    for (uint32_t n{1}; n <= UINT16_MAX + 1; n++) {
+        numbers.push_back(static_cast<uint16_t>(n));
+    }
+    for (size_t count : {numbers.size(), numbers.size() - 1, static_cast<size_t>(13), static_cast<size_t>(7), static_cast<size_t>(0)}) {
+        std::vector<uint8_t> results(count, 0xFF);
+        std::vector<uint8_t> bits((count + 7) / 8, 0xFF);
+        pc.isPrime(numbers.data(), count, results.data());
+        pc.isPrimePacked(numbers.data(), count, bits.data());
+        for (size_t i{0}; i < count; i++) {
+            const bool expected{pc.isPrime(numbers[i])};
+            if ((static_cast<uint8_t>(expected) != results[i]) || (expected != (0 != ((bits[i / 8] >> (i % 8)) & 1)))) {
+                FAIL("batch result for " << numbers[i] << " at " << i << " of " << count << " should be " << expected);
+            }
+        }
+        if (0 != (count % 8)) {
+            REQUIRE(0 == (bits.back() >> (count % 8)));
+        }
+    }
+}
+
+TEST_CASE("Test the 32-bit PrimeChecker against trial division.") {
+    PrimeChecker pc;
+    // Around the end of the lookup and the end of the uint32_t range
+    for (uint64_t first : {static_cast<uint64_t>(65000), static_cast<uint64_t>(UINT32_MAX) - 2000}) {
+        for (uint64_t n{first}; (n < first + 2000) && (n <= UINT32_MAX); n++) {
+            bool expected{(n > 1) && ((2 == n) || (0 != n % 2))};
+            for (uint64_t i{3}; expected && ((i * i) <= n); i += 2) {
+                expected = (0 != n % i);
+            }
+            if ((expected != pc.isPrime(static_cast<uint32_t>(n))) || (expected != pc.isPrime(n))) {
+                FAIL("isPrime(" << n << ") should be " << expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test the 64-bit PrimeChecker with known primes and pseudoprimes.") {
+    PrimeChecker pc;
+    // Largest primes below 2^32, 2^63 and 2^64, and Mersenne primes
+    REQUIRE(pc.isPrime(static_cast<uint32_t>(4294967291u)));
+    REQUIRE(pc.isPrime(static_cast<uint64_t>(9223372036854775783ull)));
+    REQUIRE(pc.isPrime(static_cast<uint64_t>(18446744073709551557ull)));
+    REQUIRE(pc.isPrime(static_cast<uint64_t>(2147483647ull)));
+    REQUIRE(pc.isPrime(static_cast<uint64_t>(2305843009213693951ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(UINT64_MAX)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint32_t>(UINT32_MAX)));
+    // Carmichael numbers and strong pseudoprimes to several small bases
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint32_t>(2465)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint32_t>(1373653)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint32_t>(25326001)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint32_t>(3215031751u)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(2152302898747ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(3474749660383ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(341550071728321ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(3825123056546413051ull)));
+    // Strong pseudoprimes to base 2 just above 2^32, which only the Lucas test sorts out
+    for (uint64_t n : {4294967297ull, 4297078001ull, 4297753027ull, 4298473121ull, 4304942281ull, 4310100169ull}) {
+        REQUIRE_FALSE(pc.isPrime(n));
+    }
+    // Squares and products of large primes, which have no small factor
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(4294967291ull * 4294967291ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(4294967291ull * 4294967279ull)));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint64_t>(2147483647ull * 2147483629ull)));
+    // Products of random primes above 2^31
+    std::mt19937_64 generator{42};
+    uint32_t semiprimes{0};
+    uint64_t p{0};
+    while (semiprimes < 1000) {
+        const uint32_t candidate{static_cast<uint32_t>(generator() | 0x80000001u)};
+        if (pc.isPrime(candidate)) {
+            if (0 != p) {
+                const uint64_t n{p * candidate};
+                if (pc.isPrime(n)) {
+                    FAIL("isPrime(" << n << ") should be false");
+                }
+                semiprimes++;
+            }
+            p = candidate;
+        }
+    }
+}
+
+TEST_CASE("Test PrimeChecker with other integer types.") {
+    PrimeChecker pc;
+    REQUIRE(pc.isPrime(7919));
+    REQUIRE(pc.isPrime(4294967311ll));
+    REQUIRE_FALSE(pc.isPrime(-7));
+    REQUIRE_FALSE(pc.isPrime(static_cast<uint8_t>(255)));
+}
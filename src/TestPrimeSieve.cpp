@@ -0,0 +1,57 @@
+#include "catch.hpp"
+#include "PrimeChecker.hpp"
+#include "PrimeSieve.hpp"
+
+#include <random>
+#include <vector>
+
+TEST_CASE("Test PrimeSieve against PrimeChecker for small ranges.") {
+    PrimeChecker pc;
+    // Segments of one word, so that every range spans several segments
+    PrimeSieve sieve{8};
+    std::mt19937_64 generator{42};
+    for (uint32_t i{0}; i < 200; i++) {
+        const uint64_t from{(i < 100) ? generator() % 1000 : generator() % 100000000};
+        const uint64_t to{from + generator() % 2000};
+        std::vector<uint64_t> expected;
+        for (uint64_t n{from}; n < to; n++) {
+            if (pc.isPrime(n)) {
+                expected.push_back(n);
+            }
+        }
+        std::vector<uint64_t> primes;
+        sieve.forEachPrime(from, to, [&primes](uint64_t p) { primes.push_back(p); });
+        REQUIRE(expected == primes);
+        REQUIRE(expected.size() == sieve.countPrimes(from, to));
+    }
+}
+
+TEST_CASE("Test PrimeSieve at the edges of a range.") {
+    PrimeSieve sieve;
+    REQUIRE(0 == sieve.countPrimes(0, 2));
+    REQUIRE(1 == sieve.countPrimes(0, 3));
+    REQUIRE(4 == sieve.countPrimes(0, 10));
+    REQUIRE(4 == sieve.countPrimes(2, 11));
+    REQUIRE(5 == sieve.countPrimes(2, 12));
+    REQUIRE(0 == sieve.countPrimes(24, 29));
+    REQUIRE(1 == sieve.countPrimes(29, 30));
+    REQUIRE(0 == sieve.countPrimes(30, 29));
+}
+
+TEST_CASE("Test PrimeSieve with known prime counts.") {
+    PrimeSieve sieve;
+    REQUIRE(1229 == sieve.countPrimes(0, 10000));
+    REQUIRE(5761455 == sieve.countPrimes(0, 100000000));
+    // The primes between 10^12 and 10^12 + 10^6, and a sieve that is reused further up
+    PrimeChecker pc;
+    uint64_t count{0};
+    uint64_t previous{0};
+    bool ascendingPrimes{true};
+    sieve.forEachPrime(1000000000000ull, 1000001000000ull, [&](uint64_t p) {
+        ascendingPrimes = ascendingPrimes && (p > previous) && pc.isPrime(p);
+        previous = p;
+        count++;
+    });
+    REQUIRE(ascendingPrimes);
+    REQUIRE(36249 == count);
+}
@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "PrimeChecker.hpp"
+#include "PrimeTable.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+namespace {
+// A table file next to the test runner that is removed again
+struct TableFile {
+    const std::string path{"TestPrimeTable-" + std::to_string(::getpid()) + ".bin"};
+    ~TableFile() { ::unlink(path.c_str()); }
+};
+}
+
+TEST_CASE("Test PrimeTable against the Miller-Rabin test.") {
+    TableFile file;
+    const uint64_t limit{static_cast<uint64_t>(1) << 24};
+    REQUIRE(PrimeTable::generate(file.path, limit));
+
+    PrimeTable table{file.path};
+    REQUIRE(table.valid());
+    REQUIRE(limit == table.limit());
+
+    PrimeChecker pc;
+    for (uint32_t n{0}; n < 100000; n++) {
+        REQUIRE(pc.isPrime(n) == table.isPrime(n));
+    }
+    for (uint32_t n{static_cast<uint32_t>(limit) - 100000}; n < limit; n++) {
+        REQUIRE(pc.isPrime(n) == table.isPrime(n));
+    }
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<uint32_t> distribution{0, static_cast<uint32_t>(limit) - 1};
+    for (uint32_t i{0}; i < 100000; i++) {
+        const uint32_t n{distribution(generator)};
+        REQUIRE(pc.isPrime(n) == table.isPrime(n));
+    }
+}
+
+TEST_CASE("Test PrimeChecker with a prime table.") {
+    TableFile file;
+    const uint64_t limit{1000000};
+    REQUIRE(PrimeTable::generate(file.path, limit));
+
+    PrimeChecker withTable;
+    REQUIRE(withTable.loadTable(file.path));
+    PrimeChecker without;
+    // Below the limit from the table, from there on with the Miller-Rabin test
+    for (uint32_t n{0}; n < 2 * limit; n++) {
+        REQUIRE(without.isPrime(n) == withTable.isPrime(n));
+    }
+    REQUIRE(withTable.isPrime(static_cast<uint32_t>(4294967291u)));
+    REQUIRE_FALSE(withTable.isPrime(static_cast<uint32_t>(4294967295u)));
+
+    // Copies share the table
+    PrimeChecker copy{withTable};
+    REQUIRE(copy.isPrime(static_cast<uint32_t>(999983)));
+    REQUIRE_FALSE(copy.isPrime(static_cast<uint32_t>(999981)));
+}
+
+TEST_CASE("Test PrimeTable with broken files.") {
+    TableFile file;
+    PrimeChecker pc;
+    REQUIRE_FALSE(pc.loadTable(file.path));
+    REQUIRE_FALSE(PrimeTable{file.path}.valid());
+
+    // No table and a cut off table
+    FILE *out{std::fopen(file.path.c_str(), "wb")};
+    REQUIRE(nullptr != out);
+    std::fputs("PRIMETBL but not a prime table", out);
+    std::fclose(out);
+    REQUIRE_FALSE(pc.loadTable(file.path));
+
+    REQUIRE(PrimeTable::generate(file.path, 1 << 16));
+    REQUIRE(0 == ::truncate(file.path.c_str(), 64 + 1024));
+    REQUIRE_FALSE(pc.loadTable(file.path));
+
+    // A failed load keeps the checker working
+    REQUIRE(pc.isPrime(static_cast<uint32_t>(65521)));
+    REQUIRE_FALSE(PrimeTable::generate(file.path, PrimeTable::MAXIMUM_LIMIT + 1));
+}
@@ -1,11 +1,139 @@
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "BatchChecker.hpp"
 #include "PrimeChecker.hpp"
 
+// Feeds a pipe, a terminal or another stream through the checker in large reads; a number cut at the
+// end of a read is kept for the next one
+static bool checkStream(int fd, BatchChecker &checker) {
+    std::vector<char> buffer(1 << 20);
+    size_t filled{0};
+    while (true) {
+        const ssize_t got{::read(fd, buffer.data() + filled, buffer.size() - filled)};
+        if ((0 > got) && (EINTR == errno)) {
+            continue;
+        }
+        const bool last{0 >= got};
+        filled += last ? 0 : static_cast<size_t>(got);
+        size_t used{checker.feed(buffer.data(), filled, last)};
+        if ((0 == used) && (filled == buffer.size())) {
+            // A single number fills the whole buffer
+            used = checker.feed(buffer.data(), filled, true);
+        }
+        std::memmove(buffer.data(), buffer.data() + used, filled - used);
+        filled -= used;
+        if (last) {
+            return 0 == got;
+        }
+    }
+}
+
+// Feeds a regular file through the checker straight from the page cache; anything else, e.g. a FIFO or
+// /dev/stdin, has no size to map and is read as a stream
+static bool checkFile(const char *path, BatchChecker &checker) {
+    const int fd{::open(path, O_RDONLY)};
+    if (0 > fd) {
+        std::cerr << "helloworld: Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat status;
+    bool ok{0 == ::fstat(fd, &status)};
+    if (ok && !S_ISREG(status.st_mode)) {
+        ok = checkStream(fd, checker);
+        if (!ok) {
+            std::cerr << "helloworld: Failed to read " << path << ": " << std::strerror(errno) << std::endl;
+        }
+        ::close(fd);
+        return ok;
+    }
+    if (ok && (0 < status.st_size)) {
+        const size_t size{static_cast<size_t>(status.st_size)};
+        void *data{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+        ok = (MAP_FAILED != data);
+        if (ok) {
+            ::madvise(data, size, MADV_SEQUENTIAL);
+            checker.feed(static_cast<const char *>(data), size, true);
+            ::munmap(data, size);
+        }
+    }
+    if (!ok) {
+        std::cerr << "helloworld: Failed to map " << path << ": " << std::strerror(errno) << std::endl;
+    }
+    ::close(fd);
+    return ok;
+}
+
 int main(int argc, char** argv) {
-    if (argc == 2) {
-        int number = std::stoi(argv[1]);
-        PrimeChecker pc;
-        std::cout << "Dunvald, Emrik; " << number << " is a prime number? " << pc.isPrime(number) << std::endl;
+    // Options first, then the number or the file
+    bool batch{false};
+    bool binary{false};
+    std::string table;
+    int argument{1};
+    for (; (argument < argc) && (0 == std::strncmp(argv[argument], "--", 2)); argument++) {
+        if (0 == std::strcmp(argv[argument], "--batch")) {
+            batch = true;
+        }
+        else if (0 == std::strcmp(argv[argument], "--binary")) {
+            binary = true;
+        }
+        else if (0 == std::strncmp(argv[argument], "--table=", 8)) {
+            table = argv[argument] + 8;
+        }
+        else {
+            argument = argc + 1;
+        }
+    }
+
+    PrimeChecker pc;
+    if (!table.empty() && !pc.loadTable(table)) {
+        std::cerr << "helloworld: " << table << " is no prime table; testing the numbers instead." << std::endl;
+    }
+
+    if (!batch && (argument + 1 == argc)) {
+        // The full 64-bit range; negative numbers are not primes
+        const std::string number{argv[argument]};
+        if ('-' == number[0]) {
+            std::cout << "Dunvald, Emrik; " << std::stoll(number) << " is a prime number? " << false << std::endl;
+        }
+        else {
+            const uint64_t n = std::stoull(number);
+            std::cout << "Dunvald, Emrik; " << n << " is a prime number? " << pc.isPrime(n) << std::endl;
+        }
+    }
+    else if (batch && (argument <= argc) && (argument + 1 >= argc)) {
+        // Many numbers per process: from a file or stdin, as text or 64-bit little-endian numbers
+        const auto begin = std::chrono::steady_clock::now();
+        bool ok{true};
+        uint64_t numbers{0};
+        uint64_t primes{0};
+        uint64_t invalid{0};
+        {
+            BatchChecker checker{binary ? BatchChecker::Format::Binary : BatchChecker::Format::Text, STDOUT_FILENO, pc};
+            ok = (argument < argc) ? checkFile(argv[argument], checker) : checkStream(STDIN_FILENO, checker);
+            ok = checker.flush() && ok;
+            numbers = checker.numberOfNumbers();
+            primes = checker.numberOfPrimes();
+            invalid = checker.numberOfInvalidNumbers();
+        }
+        const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+        std::cerr << "helloworld: " << numbers << " numbers (" << primes << " primes, " << invalid << " invalid) in " << seconds
+                  << " s: " << static_cast<uint64_t>((0.0 < seconds) ? static_cast<double>(numbers) / seconds : 0.0) << " numbers/s" << std::endl;
+        return ok ? 0 : 1;
+    }
+    else {
+        std::cerr << "Usage: " << argv[0] << " [--table=<file>] <number>" << std::endl;
+        std::cerr << "       " << argv[0] << " --batch [--binary] [--table=<file>] [<file>]" << std::endl;
+        std::cerr << "         --batch:  check the numbers of the file (or stdin) and print <number>;<1 if prime, 0 otherwise> for each" << std::endl;
+        std::cerr << "         --binary: the numbers are 64-bit little-endian; one byte (1 if prime, 0 otherwise) is written for each" << std::endl;
+        std::cerr << "         --table:  look up the numbers in a prime table written by helloworld-PrimeTable" << std::endl;
     }
     return 0;
 }